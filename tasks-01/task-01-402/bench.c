@@ -0,0 +1,811 @@
+#define _POSIX_C_SOURCE 200809L // clock_gettime, strtok_r
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+
+#include "date.h"
+
+#define BENCH_OPS 2000000     ///< Default calls per repetition
+#define BENCH_REPS 7          ///< Default repetitions per benchmark
+#define BENCH_MAX_REPS 64     ///< Maximum repetitions per benchmark
+#define BENCH_SET_SIZE 4096   ///< Inputs per set (power of two)
+#define BENCH_STR_LEN 32      ///< Storage per input string
+#define BENCH_MAX_RESULTS 32  ///< Maximum rows in a report
+#define BENCH_MIN_NOISE_PCT 3.0 ///< Smallest change --compare reports as real
+#define SWEEP_BATCH 1024      ///< Strings per SIMD kernel call in the sweep
+#define LEGACY_INPUT_LEN 256  ///< Copy buffer of the pre-Date_parse parser (MAX_INPUT_LEN)
+
+/**
+ * @struct BenchConfig
+ * @brief Command line options of the benchmark harness
+ */
+typedef struct
+{
+  bool help;          ///< Help flag
+  long ops;           ///< Calls per repetition
+  int reps;           ///< Repetitions per benchmark
+  uint64_t seed;      ///< Random seed for the input sets
+  bool sweep;         ///< Run the exhaustive correctness sweep
+  bool no_timing;     ///< Skip the timed benchmarks
+  char *csv_file;     ///< Write results as CSV ("-" for stdout)
+  char *compare_file; ///< Compare against a CSV written by an earlier build
+} BenchConfig;
+
+/**
+ * @struct InputSet
+ * @brief Pre-generated inputs shared by every benchmark of one kind
+ *
+ * strs/lens feed the parser, raw holds parsed fields (possibly invalid) for
+ * the validator, and valid holds calendar dates for the calculations, which
+ * require valid input.
+ */
+typedef struct
+{
+  const char *name;                   ///< Input kind ("random" or "adversarial")
+  char strs[BENCH_SET_SIZE][BENCH_STR_LEN]; ///< Date strings
+  size_t lens[BENCH_SET_SIZE];        ///< String lengths
+  Date raw[BENCH_SET_SIZE];           ///< Field values, not necessarily valid
+  Date valid[BENCH_SET_SIZE];         ///< Valid dates
+} InputSet;
+
+/**
+ * @brief Benchmark body: performs ops calls and returns a checksum
+ */
+typedef uint64_t (*BenchFn)(const InputSet *set, long ops);
+
+/**
+ * @struct BenchResult
+ * @brief Timing summary of one benchmark on one input set
+ */
+typedef struct
+{
+  char function[16]; ///< Benchmarked function
+  char input[16];    ///< Input kind
+  double median_ns;  ///< Median ns/op over the repetitions
+  double min_ns;     ///< Fastest repetition, ns/op
+  double stddev_pct; ///< Standard deviation as a percentage of the mean
+  double mops;       ///< Throughput in million ops per second (from the median)
+} BenchResult;
+
+/* Command line */
+void parse_args(int argc, char *argv[], BenchConfig *config); // CLI argument parser
+void print_help(void);                                        // Displays usage help
+void print_error(const char *msg);                            // Prints an error and exits
+
+/* Input generation */
+uint64_t next_random(uint64_t *state);                      // splitmix64 generator
+void make_random_set(InputSet *set, uint64_t seed);         // Uniform valid ISO dates
+void make_adversarial_set(InputSet *set, uint64_t seed);    // Edge cases and malformed input
+
+/* Benchmarks */
+uint64_t bench_parse(const InputSet *set, long ops);    // Date_parse
+uint64_t bench_strtok(const InputSet *set, long ops);   // Legacy strtok_r/atoi parse (baseline)
+bool legacy_parse(const char *str, Date *date);         // The parser Date_parse replaced
+uint64_t bench_validate(const InputSet *set, long ops); // Date_validate
+uint64_t bench_dow(const InputSet *set, long ops);      // Date_calc_day_of_week
+uint64_t bench_doy(const InputSet *set, long ops);      // Date_calc_day_of_year
+uint64_t bench_diff(const InputSet *set, long ops);     // Date_calc_diff
+double now_ns(void);                                    // Monotonic clock in ns
+void run_benchmark(const BenchConfig *config, const char *name, BenchFn fn,
+                   const InputSet *set, BenchResult *result); // Times one benchmark
+
+/* Reporting */
+void print_results(const BenchResult *results, int count);                   // Human-readable table
+void write_csv(const char *filename, const BenchResult *results, int count);   // Machine-readable results
+void compare_results(const char *filename, const BenchResult *results, int count); // Delta vs earlier run
+
+/* Correctness sweep */
+int sweep_calendar(void);    // Checks every valid date against every API
+int sweep_iso_kernels(void); // Checks the SIMD kernels on valid and invalid strings
+
+/**
+ * @brief Benchmark table: name and body
+ */
+static const struct
+{
+  const char *name;
+  BenchFn fn;
+} benchmarks[] = {
+    {"parse", bench_parse},
+    {"strtok", bench_strtok},
+    {"validate", bench_validate},
+    {"dow", bench_dow},
+    {"doy", bench_doy},
+    {"diff", bench_diff},
+};
+
+static volatile uint64_t sink; ///< Keeps benchmark results observable
+
+/* ======================== MAIN FUNCTION ======================== */
+
+/**
+ * @brief Benchmark entry point
+ * @param argc Argument count
+ * @param argv Argument vector
+ * @return EXIT_SUCCESS, or EXIT_FAILURE if the sweep found a mismatch
+ */
+int main(int argc, char *argv[])
+{
+  BenchConfig config = {.ops = BENCH_OPS, .reps = BENCH_REPS, .seed = 42};
+  parse_args(argc, argv, &config);
+
+  if (config.help)
+  {
+    print_help();
+    return 0;
+  }
+
+  if (config.sweep)
+  {
+    int failures = sweep_calendar() + sweep_iso_kernels();
+    if (failures)
+    {
+      fprintf(stderr, "Error: correctness sweep found %d mismatches\n", failures);
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (config.no_timing)
+    return 0;
+
+  static InputSet sets[2];
+  make_random_set(&sets[0], config.seed);
+  make_adversarial_set(&sets[1], config.seed);
+
+  BenchResult results[BENCH_MAX_RESULTS];
+  int count = 0;
+  for (size_t b = 0; b < sizeof(benchmarks) / sizeof(benchmarks[0]); b++)
+  {
+    for (int s = 0; s < 2; s++)
+    {
+      run_benchmark(&config, benchmarks[b].name, benchmarks[b].fn, &sets[s], &results[count++]);
+    }
+  }
+
+  print_results(results, count);
+  if (config.csv_file)
+  {
+    write_csv(config.csv_file, results, count);
+  }
+  if (config.compare_file)
+  {
+    compare_results(config.compare_file, results, count);
+  }
+  return 0;
+}
+
+/* ================== COMMAND LINE FUNCTIONS ==================== */
+
+/**
+ * @brief Parses command line arguments
+ * @param argc Argument count
+ * @param argv Argument vector
+ * @param config Pointer to BenchConfig structure
+ */
+void parse_args(int argc, char *argv[], BenchConfig *config)
+{
+  for (int i = 1; i < argc; i++)
+  {
+    const char *arg = argv[i];
+    bool has_value = i + 1 < argc;
+
+    if (strcmp(arg, "-h") == 0 || strcmp(arg, "--help") == 0)
+    {
+      config->help = true;
+    }
+    else if (strcmp(arg, "--sweep") == 0)
+    {
+      config->sweep = true;
+    }
+    else if (strcmp(arg, "--no-timing") == 0)
+    {
+      config->no_timing = true;
+    }
+    else if ((strcmp(arg, "-n") == 0 || strcmp(arg, "--ops") == 0) && has_value)
+    {
+      config->ops = strtol(argv[++i], NULL, 10);
+      if (config->ops <= 0)
+        print_error("Operation count must be positive");
+    }
+    else if ((strcmp(arg, "-r") == 0 || strcmp(arg, "--reps") == 0) && has_value)
+    {
+      config->reps = (int)strtol(argv[++i], NULL, 10);
+      if (config->reps < 1 || config->reps > BENCH_MAX_REPS)
+        print_error("Repetitions must be between 1 and 64");
+    }
+    else if (strcmp(arg, "--seed") == 0 && has_value)
+    {
+      config->seed = strtoull(argv[++i], NULL, 10);
+    }
+    else if (strcmp(arg, "--csv") == 0 && has_value)
+    {
+      config->csv_file = argv[++i];
+    }
+    else if (strcmp(arg, "--compare") == 0 && has_value)
+    {
+      config->compare_file = argv[++i];
+    }
+    else
+    {
+      print_error("Unknown or incomplete argument (see --help)");
+    }
+  }
+}
+
+/**
+ * @brief Displays usage help
+ */
+void print_help(void)
+{
+  printf("Usage: benchmark [options]\n");
+  printf("Options:\n");
+  printf("  -n, --ops N      Calls per repetition (default %d)\n", BENCH_OPS);
+  printf("  -r, --reps N     Repetitions per benchmark, 1-%d (default %d)\n", BENCH_MAX_REPS, BENCH_REPS);
+  printf("  --seed N         Seed for the generated inputs (default 42)\n");
+  printf("  --csv FILE       Also write the results as CSV (\"-\" for stdout)\n");
+  printf("  --compare FILE   Compare against a CSV from an earlier build\n");
+  printf("  --sweep          Check every date 0001-01-01..9999-12-31 first\n");
+  printf("  --no-timing      Skip the timed benchmarks\n");
+  printf("  -h, --help       Show this help message\n");
+}
+
+/**
+ * @brief Prints an error message to stderr and exits
+ * @param msg Error message to print
+ */
+void print_error(const char *msg)
+{
+  fprintf(stderr, "Error: %s\n", msg);
+  exit(EXIT_FAILURE);
+}
+
+/* ====================== INPUT GENERATION ====================== */
+
+/**
+ * @brief splitmix64 pseudo-random generator
+ * @param state Generator state
+ * @return Next 64-bit value
+ */
+uint64_t next_random(uint64_t *state)
+{
+  uint64_t z = (*state += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+/**
+ * @brief Fills a set with uniformly distributed valid ISO dates
+ * @param set Set to fill
+ * @param seed Random seed
+ */
+void make_random_set(InputSet *set, uint64_t seed)
+{
+  uint64_t state = seed;
+  set->name = "random";
+  for (int i = 0; i < BENCH_SET_SIZE; i++)
+  {
+    Date date;
+    Date_from_serial(1 + (int)(next_random(&state) % (CALENDAR_DAYS - 1)), &date);
+    Date_to_string(&date, set->strs[i], BENCH_STR_LEN);
+    set->lens[i] = strlen(set->strs[i]);
+    set->raw[i] = date;
+    set->valid[i] = date;
+  }
+}
+
+/**
+ * @brief Fills a set with edge cases and malformed input in random order
+ * @param set Set to fill
+ * @param seed Random seed
+ *
+ * Strings mix every accepted format with the ways each one can fail, so the
+ * parser's branches are exercised unpredictably. Raw dates break each
+ * validation rule; valid dates sit on month, year and century boundaries.
+ */
+void make_adversarial_set(InputSet *set, uint64_t seed)
+{
+  static const char *strings[] = {
+      "2023-02-29", "2024-02-29", "1900-02-29", "2000-02-29", "2024-04-31",
+      "0000-01-01", "9999-12-31", "0001-01-01", "2024-13-01", "2024-00-10",
+      "20240229", "99999999", "1234567890-01-01", "2024-01-01x", "   2024-01-01   ",
+      "2020-W53-7", "2021-W53-1", "2024W011", "2024-W00-1", "December 31, 9999",
+      "1 jan 0001", "ju 4 2024", "septembe 30 2024", "marchy 1 2024", "2024 feb",
+      "", "abc", "2024//01//02", "2024-1-1", "31.12.2024", "-2024-01-01", "2024 12 25"};
+  static const Date raw[] = {
+      {2023, 2, 29}, {2024, 2, 30}, {1900, 2, 29}, {2000, 2, 29}, {2024, 4, 31},
+      {0, 1, 1}, {10000, 1, 1}, {-5, 6, 15}, {2024, 0, 10}, {2024, 13, 1},
+      {2024, 1, 0}, {2024, 1, 32}, {9999, 12, 31}, {1, 1, 1}, {2024, 11, 30}, {2024, 6, 31}};
+  uint64_t state = seed ^ 0xADE5A1ull;
+  const size_t string_count = sizeof(strings) / sizeof(strings[0]);
+  const size_t raw_count = sizeof(raw) / sizeof(raw[0]);
+
+  set->name = "adversarial";
+  for (int i = 0; i < BENCH_SET_SIZE; i++)
+  {
+    const char *s = strings[next_random(&state) % string_count];
+    snprintf(set->strs[i], BENCH_STR_LEN, "%s", s);
+    set->lens[i] = strlen(set->strs[i]);
+    set->raw[i] = raw[next_random(&state) % raw_count];
+
+    // Boundary dates: first/last day of a month in a century, 400 or leap year
+    static const int years[] = {1, 1600, 1700, 1900, 2000, 2023, 2024, 2100, 9999};
+    Date date = {years[next_random(&state) % 9], 1 + (int)(next_random(&state) % 12), 1};
+    if (next_random(&state) & 1)
+      date.day = Date_days_in_month(date.year, date.month);
+    set->valid[i] = date;
+  }
+}
+
+/* ======================== BENCHMARKS ========================== */
+
+/**
+ * @brief Parses set strings with Date_parse
+ * @param set Input set
+ * @param ops Number of calls
+ * @return Checksum of the results
+ */
+uint64_t bench_parse(const InputSet *set, long ops)
+{
+  uint64_t sum = 0;
+  for (long i = 0; i < ops; i++)
+  {
+    size_t k = (size_t)i & (BENCH_SET_SIZE - 1);
+    Date date;
+    size_t error_pos = 0;
+    DateParseStatus status = Date_parse(set->strs[k], set->lens[k], &date, &error_pos);
+    sum += status == DATE_PARSE_OK ? (uint64_t)date.day : error_pos;
+  }
+  return sum;
+}
+
+/**
+ * @brief Parses set strings with the legacy strtok_r/atoi parser
+ * @param set Input set
+ * @param ops Number of calls
+ * @return Checksum of the results
+ *
+ * Baseline for bench_parse: the path the CLI used before Date_parse.
+ */
+uint64_t bench_strtok(const InputSet *set, long ops)
+{
+  uint64_t sum = 0;
+  for (long i = 0; i < ops; i++)
+  {
+    Date date;
+    sum += legacy_parse(set->strs[(size_t)i & (BENCH_SET_SIZE - 1)], &date) ? (uint64_t)date.day : 0;
+  }
+  return sum;
+}
+
+/**
+ * @brief Parses YYYY-MM-DD or YYYY MM DD the way the CLI did before Date_parse
+ * @param str Input date string
+ * @param date Output date (fields unchecked)
+ * @return true if three fields were found
+ *
+ * Copies the input, splits it with strtok_r and converts each field with
+ * atoi. Kept verbatim so the speedup of Date_parse can be re-measured.
+ */
+bool legacy_parse(const char *str, Date *date)
+{
+  char copy[LEGACY_INPUT_LEN];
+  strncpy(copy, str, sizeof(copy));
+  copy[sizeof(copy) - 1] = '\0';
+
+  char *save = NULL;
+  char *token = strtok_r(copy, " -", &save);
+  if (!token)
+    return false;
+  date->year = atoi(token);
+
+  token = strtok_r(NULL, " -", &save);
+  if (!token)
+    return false;
+  date->month = atoi(token);
+
+  token = strtok_r(NULL, " -", &save);
+  if (!token)
+    return false;
+  date->day = atoi(token);
+
+  return true;
+}
+
+/**
+ * @brief Validates raw set dates with Date_validate
+ * @param set Input set
+ * @param ops Number of calls
+ * @return Checksum of the results
+ */
+uint64_t bench_validate(const InputSet *set, long ops)
+{
+  uint64_t sum = 0;
+  for (long i = 0; i < ops; i++)
+  {
+    sum += Date_validate(&set->raw[(size_t)i & (BENCH_SET_SIZE - 1)]);
+  }
+  return sum;
+}
+
+/**
+ * @brief Computes weekdays with Date_calc_day_of_week
+ * @param set Input set
+ * @param ops Number of calls
+ * @return Checksum of the results
+ */
+uint64_t bench_dow(const InputSet *set, long ops)
+{
+  uint64_t sum = 0;
+  for (long i = 0; i < ops; i++)
+  {
+    sum += Date_calc_day_of_week(&set->valid[(size_t)i & (BENCH_SET_SIZE - 1)]);
+  }
+  return sum;
+}
+
+/**
+ * @brief Computes days of year with Date_calc_day_of_year
+ * @param set Input set
+ * @param ops Number of calls
+ * @return Checksum of the results
+ */
+uint64_t bench_doy(const InputSet *set, long ops)
+{
+  uint64_t sum = 0;
+  for (long i = 0; i < ops; i++)
+  {
+    sum += Date_calc_day_of_year(&set->valid[(size_t)i & (BENCH_SET_SIZE - 1)]);
+  }
+  return sum;
+}
+
+/**
+ * @brief Formats differences between set dates with Date_calc_diff
+ * @param set Input set
+ * @param ops Number of calls
+ * @return Checksum of the results
+ */
+uint64_t bench_diff(const InputSet *set, long ops)
+{
+  uint64_t sum = 0;
+  char buf[100];
+  for (long i = 0; i < ops; i++)
+  {
+    size_t k = (size_t)i & (BENCH_SET_SIZE - 1);
+    size_t r = (k * 7 + 3) & (BENCH_SET_SIZE - 1);
+    Date_calc_diff(&set->valid[k], &set->valid[r], buf, sizeof(buf));
+    sum += (unsigned char)buf[0];
+  }
+  return sum;
+}
+
+/**
+ * @brief Reads the monotonic clock
+ * @return Current time in nanoseconds
+ */
+double now_ns(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/**
+ * @brief Compares doubles for qsort
+ */
+static int compare_double(const void *a, const void *b)
+{
+  double x = *(const double *)a, y = *(const double *)b;
+  return (x > y) - (x < y);
+}
+
+/**
+ * @brief Times one benchmark on one input set
+ * @param config Benchmark options
+ * @param name Function name for the report
+ * @param fn Benchmark body
+ * @param set Input set
+ * @param result Output summary
+ *
+ * One untimed warm-up pass fills the caches and branch predictors, then
+ * each repetition is timed separately so the spread can be reported.
+ */
+void run_benchmark(const BenchConfig *config, const char *name, BenchFn fn,
+                   const InputSet *set, BenchResult *result)
+{
+  double samples[BENCH_MAX_REPS];
+  double mean = 0.0, variance = 0.0;
+
+  sink += fn(set, config->ops / 10 + 1);
+  for (int r = 0; r < config->reps; r++)
+  {
+    double start = now_ns();
+    sink += fn(set, config->ops);
+    samples[r] = (now_ns() - start) / (double)config->ops;
+    mean += samples[r];
+  }
+  mean /= config->reps;
+  for (int r = 0; r < config->reps; r++)
+  {
+    variance += (samples[r] - mean) * (samples[r] - mean);
+  }
+  variance /= config->reps;
+
+  qsort(samples, (size_t)config->reps, sizeof(double), compare_double);
+  snprintf(result->function, sizeof(result->function), "%s", name);
+  snprintf(result->input, sizeof(result->input), "%s", set->name);
+  result->median_ns = samples[config->reps / 2];
+  result->min_ns = samples[0];
+  result->stddev_pct = mean > 0.0 ? 100.0 * sqrt(variance) / mean : 0.0;
+  result->mops = result->median_ns > 0.0 ? 1e3 / result->median_ns : 0.0;
+}
+
+/* ========================= REPORTING ========================== */
+
+/**
+ * @brief Prints results as an aligned table
+ * @param results Benchmark results
+ * @param count Number of results
+ */
+void print_results(const BenchResult *results, int count)
+{
+  printf("%-10s %-12s %10s %10s %9s %10s\n", "function", "input", "ns/op", "min ns", "stddev", "Mops/s");
+  for (int i = 0; i < count; i++)
+  {
+    printf("%-10s %-12s %10.2f %10.2f %8.1f%% %10.2f\n", results[i].function, results[i].input,
+           results[i].median_ns, results[i].min_ns, results[i].stddev_pct, results[i].mops);
+  }
+}
+
+/**
+ * @brief Writes results as CSV
+ * @param filename Output file, or "-" for stdout
+ * @param results Benchmark results
+ * @param count Number of results
+ */
+void write_csv(const char *filename, const BenchResult *results, int count)
+{
+  FILE *out = strcmp(filename, "-") == 0 ? stdout : fopen(filename, "w");
+  if (out == NULL)
+    print_error("Could not open CSV file");
+
+  fprintf(out, "function,input,ns_per_op,min_ns,stddev_pct,mops\n");
+  for (int i = 0; i < count; i++)
+  {
+    fprintf(out, "%s,%s,%.3f,%.3f,%.2f,%.3f\n", results[i].function, results[i].input,
+            results[i].median_ns, results[i].min_ns, results[i].stddev_pct, results[i].mops);
+  }
+  if (out != stdout)
+    fclose(out);
+}
+
+/**
+ * @brief Prints the change of each result against an earlier CSV
+ * @param filename CSV written by --csv
+ * @param results Benchmark results of this build
+ * @param count Number of results
+ *
+ * A change is flagged only when it exceeds the combined spread of both
+ * runs (at least BENCH_MIN_NOISE_PCT), so noise is not reported as a
+ * regression.
+ */
+void compare_results(const char *filename, const BenchResult *results, int count)
+{
+  FILE *in = fopen(filename, "r");
+  if (in == NULL)
+    print_error("Could not open comparison file");
+
+  BenchResult old[BENCH_MAX_RESULTS];
+  int old_count = 0;
+  char line[256];
+  while (fgets(line, sizeof(line), in) && old_count < BENCH_MAX_RESULTS)
+  {
+    BenchResult *r = &old[old_count];
+    if (sscanf(line, "%15[^,],%15[^,],%lf,%lf,%lf,%lf", r->function, r->input,
+               &r->median_ns, &r->min_ns, &r->stddev_pct, &r->mops) == 6)
+      old_count++;
+  }
+  fclose(in);
+
+  printf("\n%-10s %-12s %10s %10s %9s\n", "function", "input", "old ns", "new ns", "change");
+  for (int i = 0; i < count; i++)
+  {
+    const BenchResult *prev = NULL;
+    for (int j = 0; j < old_count && prev == NULL; j++)
+    {
+      if (strcmp(old[j].function, results[i].function) == 0 && strcmp(old[j].input, results[i].input) == 0)
+        prev = &old[j];
+    }
+    if (prev == NULL || prev->median_ns <= 0.0)
+    {
+      printf("%-10s %-12s %10s %10.2f %9s\n", results[i].function, results[i].input, "-",
+             results[i].median_ns, "new");
+      continue;
+    }
+
+    double change = 100.0 * (results[i].median_ns - prev->median_ns) / prev->median_ns;
+    double noise = prev->stddev_pct + results[i].stddev_pct;
+    if (noise < BENCH_MIN_NOISE_PCT)
+      noise = BENCH_MIN_NOISE_PCT;
+    const char *verdict = change > noise ? "slower" : change < -noise ? "faster" : "";
+    printf("%-10s %-12s %10.2f %10.2f %+8.1f%% %s\n", results[i].function, results[i].input,
+           prev->median_ns, results[i].median_ns, change, verdict);
+  }
+}
+
+/* ===================== CORRECTNESS SWEEP ====================== */
+
+/**
+ * @brief Reports a sweep mismatch
+ * @param check Name of the failed check
+ * @param date Date being checked
+ * @param failures Failure counter (only the first few are printed)
+ */
+static void report_mismatch(const char *check, const Date *date, int *failures)
+{
+  if (++*failures <= 10)
+  {
+    fprintf(stderr, "Mismatch in %s at %04d-%02d-%02d\n", check, date->year, date->month, date->day);
+  }
+}
+
+/**
+ * @brief Checks every date from 0001-01-01 to 9999-12-31
+ * @return Number of mismatches
+ *
+ * Walks the serial days in order and cross-checks serial conversion,
+ * validation, both weekday implementations, day of year, formatting and
+ * parsing, Date_add_days and a DateCursor advanced one day at a time.
+ */
+int sweep_calendar(void)
+{
+  int failures = 0;
+  int last = CALENDAR_DAYS - 1;
+  DateCursor cursor;
+  Date first = {1, 1, 1};
+  DateCursor_init(&cursor, &first);
+
+  for (int serial = 1; serial <= last; serial++)
+  {
+    Date date, parsed;
+    char buf[16];
+    size_t error_pos;
+
+    Date_from_serial(serial, &date);
+    if (Date_to_serial(&date) != serial)
+      report_mismatch("serial round trip", &date, &failures);
+    if (Date_validate(&date) != DATE_OK)
+      report_mismatch("Date_validate", &date, &failures);
+
+    int dow = Date_calc_day_of_week(&date);
+    if (dow != Date_weekday(date.year, date.month, date.day) || dow != serial % 7)
+      report_mismatch("day of week (table vs arithmetic)", &date, &failures);
+
+    Date jan1 = {date.year, 1, 1};
+    int doy = serial - Date_to_serial(&jan1) + 1;
+    if (Date_calc_day_of_year(&date) != doy)
+      report_mismatch("day of year", &date, &failures);
+
+    if (cursor.serial != serial || cursor.day_of_week != dow || cursor.day_of_year != doy ||
+        cursor.date.year != date.year || cursor.date.month != date.month || cursor.date.day != date.day ||
+        cursor.leap != Date_is_leap_year(&date))
+      report_mismatch("DateCursor", &date, &failures);
+
+    Date_to_string(&date, buf, sizeof(buf));
+    if (Date_parse(buf, strlen(buf), &parsed, &error_pos) != DATE_PARSE_OK ||
+        parsed.year != date.year || parsed.month != date.month || parsed.day != date.day)
+      report_mismatch("Date_parse round trip", &date, &failures);
+
+    if (serial < last)
+    {
+      Date shifted;
+      if (!Date_add_days(&date, 1, &shifted) || Date_to_serial(&shifted) != serial + 1)
+        report_mismatch("Date_add_days", &date, &failures);
+      DateCursor_advance(&cursor, 1);
+    }
+  }
+
+  printf("sweep: %d dates checked, %d mismatches\n", last, failures);
+  return failures;
+}
+
+/**
+ * @brief Runs one kernel over a batch and compares it with the expected flags
+ * @param name Kernel name
+ * @param fn Kernel
+ * @param ptrs Strings of the batch
+ * @param count Batch size
+ * @param expected Expected validity per string
+ * @param dates Expected dates for valid strings
+ * @param failures Failure counter
+ */
+static void check_kernel(const char *name, IsoBatchFn fn, const char *const *ptrs, int count,
+                         const unsigned char *expected, const Date *dates, int *failures)
+{
+  Date out[SWEEP_BATCH];
+  unsigned char valid[SWEEP_BATCH];
+  fn(ptrs, count, out, valid);
+  for (int i = 0; i < count; i++)
+  {
+    if (valid[i] != expected[i] ||
+        (valid[i] && (out[i].year != dates[i].year || out[i].month != dates[i].month || out[i].day != dates[i].day)))
+    {
+      report_mismatch(name, &dates[i], failures);
+    }
+  }
+}
+
+/**
+ * @brief Checks every fixed-width ISO kernel on valid and invalid strings
+ * @return Number of mismatches
+ *
+ * Covers years 0000-9999, months 00-13 and days 00-32, so every calendar
+ * rule is exercised on both sides. Each available kernel must agree with
+ * Date_validate.
+ */
+int sweep_iso_kernels(void)
+{
+  static char strs[SWEEP_BATCH][BENCH_STR_LEN];
+  const char *ptrs[SWEEP_BATCH];
+  unsigned char expected[SWEEP_BATCH];
+  Date dates[SWEEP_BATCH];
+  int failures = 0, count = 0;
+  long checked = 0;
+
+  struct
+  {
+    const char *name;
+    IsoBatchFn fn;
+  } kernels[3] = {{"scalar kernel", Date_parse_iso_batch_scalar}};
+  int kernel_count = 1;
+#if DATE_SIMD_X86
+  if (__builtin_cpu_supports("sse4.1"))
+  {
+    kernels[kernel_count].name = "sse4.1 kernel";
+    kernels[kernel_count++].fn = Date_parse_iso_batch_sse41;
+  }
+  if (__builtin_cpu_supports("avx2"))
+  {
+    kernels[kernel_count].name = "avx2 kernel";
+    kernels[kernel_count++].fn = Date_parse_iso_batch_avx2;
+  }
+#endif
+
+  for (int i = 0; i < SWEEP_BATCH; i++)
+  {
+    ptrs[i] = strs[i];
+  }
+
+  for (int year = 0; year <= 9999; year++)
+  {
+    for (int month = 0; month <= 13; month++)
+    {
+      for (int day = 0; day <= 32; day++)
+      {
+        Date date = {year, month, day};
+        memset(strs[count], 0, BENCH_STR_LEN);
+        snprintf(strs[count], BENCH_STR_LEN, "%04d-%02d-%02d", year, month, day);
+        expected[count] = Date_validate(&date) == DATE_OK;
+        dates[count] = date;
+        if (++count == SWEEP_BATCH || (year == 9999 && month == 13 && day == 32))
+        {
+          for (int k = 0; k < kernel_count; k++)
+          {
+            check_kernel(kernels[k].name, kernels[k].fn, ptrs, count, expected, dates, &failures);
+          }
+          checked += count;
+          count = 0;
+        }
+      }
+    }
+  }
+
+  printf("sweep: %ld ISO strings checked with %d kernels, %d mismatches\n", checked, kernel_count, failures);
+  return failures;
+}
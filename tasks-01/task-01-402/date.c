@@ -0,0 +1,1350 @@
+#define _POSIX_C_SOURCE 200809L // localtime_r
+
+#include "date.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <ctype.h>
+
+#if DATE_SIMD_X86
+#include <immintrin.h>
+#endif
+
+#define UNIX_EPOCH_SERIAL 719163 ///< Serial day of 1970-01-01
+
+/* Internal helpers */
+static DateStatus check_range(const Date *date);     // Component range checks
+static DateStatus check_gregorian(const Date *date); // Month length checks
+static void format_difference_string(int sign, int years, int months, int days,
+                                     char *buf, size_t size); // Difference text
+
+/* ====================== DATE VALIDATION ======================= */
+
+/**
+ * @brief Validates a Date structure
+ * @param date Pointer to Date structure
+ * @return DATE_OK if the date is valid, otherwise the first rule it breaks
+ */
+DateStatus Date_validate(const Date *date)
+{
+  DateStatus status = check_range(date);
+  if (status != DATE_OK)
+    return status;
+  return check_gregorian(date);
+}
+
+/**
+ * @brief Checks whether a Date structure is valid
+ * @param date Pointer to Date structure
+ * @return true if date is valid, false otherwise
+ */
+bool Date_is_valid(const Date *date)
+{
+  return Date_validate(date) == DATE_OK;
+}
+
+/**
+ * @brief Describes a validation status
+ * @param status Status returned by Date_validate
+ * @return Static message string
+ */
+const char *Date_status_message(DateStatus status)
+{
+  switch (status)
+  {
+  case DATE_OK:
+    return "Valid date";
+  case DATE_ERR_YEAR_NOT_POSITIVE:
+    return "Year must be positive";
+  case DATE_ERR_YEAR_TOO_LARGE:
+    return "Year must be at most 9999";
+  case DATE_ERR_MONTH_RANGE:
+    return "Month must be 1-12";
+  case DATE_ERR_DAY_RANGE:
+    return "Day must be 1-31";
+  case DATE_ERR_DAY_30:
+    return "This month has maximum 30 days";
+  case DATE_ERR_FEB_LEAP:
+    return "February has 29 days in a leap year";
+  case DATE_ERR_FEB_COMMON:
+    return "February has 28 days in a not leap year";
+  }
+  return "Unknown error";
+}
+
+/**
+ * @brief Checks if a year is a leap year
+ * @param date Pointer to Date structure
+ * @return true if leap year, false otherwise
+ */
+bool Date_is_leap_year(const Date *date)
+{
+  int year = date->year;
+  if (year % 400 == 0)
+    return true;
+  if (year % 100 == 0)
+    return false;
+  if (year % 4 == 0)
+    return true;
+  return false;
+}
+
+/**
+ * @brief Checks if date components are within valid ranges
+ * @param date Pointer to Date structure
+ * @return DATE_OK or the out-of-range component
+ */
+static DateStatus check_range(const Date *date)
+{
+  if (date->year < 1)
+    return DATE_ERR_YEAR_NOT_POSITIVE;
+  if (date->year > 9999)
+    return DATE_ERR_YEAR_TOO_LARGE;
+  if (date->month < 1 || date->month > 12)
+    return DATE_ERR_MONTH_RANGE;
+  if (date->day < 1 || date->day > 31)
+    return DATE_ERR_DAY_RANGE;
+  return DATE_OK;
+}
+
+/**
+ * @brief Validates date according to Gregorian calendar rules
+ * @param date Pointer to Date structure with in-range components
+ * @return DATE_OK or the month-length rule that is broken
+ */
+static DateStatus check_gregorian(const Date *date)
+{
+  switch (date->month)
+  {
+  case 4:
+  case 6:
+  case 9:
+  case 11:
+    if (date->day > 30)
+      return DATE_ERR_DAY_30;
+    break;
+
+  case 2:
+    if (Date_is_leap_year(date))
+    {
+      if (date->day > 29)
+        return DATE_ERR_FEB_LEAP;
+    }
+    else if (date->day > 28)
+    {
+      return DATE_ERR_FEB_COMMON;
+    }
+    break;
+  }
+  return DATE_OK;
+}
+
+/* ==================== DATE CALCULATION FUNCTIONS =============== */
+
+/**
+ * @brief Cumulative days before each month, indexed by [leap][month]
+ */
+static const int days_before_month[2][13] = {
+    {0, 0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334},
+    {0, 0, 31, 60, 91, 121, 152, 182, 213, 244, 274, 305, 335}};
+
+/**
+ * @brief Weekday of 1 January for each year of the 400-year Gregorian cycle
+ *
+ * Indexed by year % 400 (0=Sunday). The Gregorian calendar repeats exactly
+ * every 400 years (146097 days, a multiple of 7), so this table covers the
+ * whole proleptic range. Entries match Date_weekday(year, 1, 1).
+ */
+const unsigned char Date_year_start_dow[400] = {
+    6, 1, 2, 3, 4, 6, 0, 1, 2, 4, 5, 6, 0, 2, 3, 4, 5, 0, 1, 2,
+    3, 5, 6, 0, 1, 3, 4, 5, 6, 1, 2, 3, 4, 6, 0, 1, 2, 4, 5, 6,
+    0, 2, 3, 4, 5, 0, 1, 2, 3, 5, 6, 0, 1, 3, 4, 5, 6, 1, 2, 3,
+    4, 6, 0, 1, 2, 4, 5, 6, 0, 2, 3, 4, 5, 0, 1, 2, 3, 5, 6, 0,
+    1, 3, 4, 5, 6, 1, 2, 3, 4, 6, 0, 1, 2, 4, 5, 6, 0, 2, 3, 4,
+    5, 6, 0, 1, 2, 4, 5, 6, 0, 2, 3, 4, 5, 0, 1, 2, 3, 5, 6, 0,
+    1, 3, 4, 5, 6, 1, 2, 3, 4, 6, 0, 1, 2, 4, 5, 6, 0, 2, 3, 4,
+    5, 0, 1, 2, 3, 5, 6, 0, 1, 3, 4, 5, 6, 1, 2, 3, 4, 6, 0, 1,
+    2, 4, 5, 6, 0, 2, 3, 4, 5, 0, 1, 2, 3, 5, 6, 0, 1, 3, 4, 5,
+    6, 1, 2, 3, 4, 6, 0, 1, 2, 4, 5, 6, 0, 2, 3, 4, 5, 0, 1, 2,
+    3, 4, 5, 6, 0, 2, 3, 4, 5, 0, 1, 2, 3, 5, 6, 0, 1, 3, 4, 5,
+    6, 1, 2, 3, 4, 6, 0, 1, 2, 4, 5, 6, 0, 2, 3, 4, 5, 0, 1, 2,
+    3, 5, 6, 0, 1, 3, 4, 5, 6, 1, 2, 3, 4, 6, 0, 1, 2, 4, 5, 6,
+    0, 2, 3, 4, 5, 0, 1, 2, 3, 5, 6, 0, 1, 3, 4, 5, 6, 1, 2, 3,
+    4, 6, 0, 1, 2, 4, 5, 6, 0, 2, 3, 4, 5, 0, 1, 2, 3, 5, 6, 0,
+    1, 2, 3, 4, 5, 0, 1, 2, 3, 5, 6, 0, 1, 3, 4, 5, 6, 1, 2, 3,
+    4, 6, 0, 1, 2, 4, 5, 6, 0, 2, 3, 4, 5, 0, 1, 2, 3, 5, 6, 0,
+    1, 3, 4, 5, 6, 1, 2, 3, 4, 6, 0, 1, 2, 4, 5, 6, 0, 2, 3, 4,
+    5, 0, 1, 2, 3, 5, 6, 0, 1, 3, 4, 5, 6, 1, 2, 3, 4, 6, 0, 1,
+    2, 4, 5, 6, 0, 2, 3, 4, 5, 0, 1, 2, 3, 5, 6, 0, 1, 3, 4, 5};
+
+/**
+ * @brief Calculates the day of year for a given date
+ * @param date Pointer to Date structure
+ * @return Day of year (1-366)
+ */
+int Date_calc_day_of_year(const Date *date)
+{
+  return days_before_month[Date_is_leap_year(date)][date->month] + date->day;
+}
+
+/**
+ * @brief Calculates the day of week for a given date
+ * @param date Pointer to Date structure
+ * @return Day of week (0=Sunday, 6=Saturday)
+ *
+ * Uses the 400-year cycle table, so it is valid for the whole proleptic
+ * Gregorian range and does not depend on the process time zone.
+ */
+int Date_calc_day_of_week(const Date *date)
+{
+  return (Date_year_start_dow[date->year % 400] + Date_calc_day_of_year(date) - 1) % 7;
+}
+
+/**
+ * @brief Pure integer day-of-week kernel (proleptic Gregorian)
+ * @param year Year (>= 1)
+ * @param month Month (1-12)
+ * @param day Day of month
+ * @return Day of week (0=Sunday, 6=Saturday)
+ *
+ * Sakamoto's method: January and February are counted as months of the
+ * previous year so that leap days fall at the end of the shifted year.
+ */
+int Date_weekday(int year, int month, int day)
+{
+  static const int offsets[] = {0, 3, 2, 5, 0, 3, 5, 1, 4, 6, 2, 4};
+  year -= month < 3;
+  return (year + year / 4 - year / 100 + year / 400 + offsets[month - 1] + day) % 7;
+}
+
+/**
+ * @brief Returns the English name of a weekday
+ * @param dow Day of week (0=Sunday, 6=Saturday)
+ * @return Weekday name
+ */
+const char *Date_day_name(int dow)
+{
+  static const char *days[] = {"Sunday", "Monday", "Tuesday", "Wednesday",
+                               "Thursday", "Friday", "Saturday"};
+  return days[dow];
+}
+
+/**
+ * @brief Returns the number of days in a month
+ * @param year Year (used for February)
+ * @param month Month (1-12)
+ * @return Days in the month
+ */
+int Date_days_in_month(int year, int month)
+{
+  static const int days_in_month[] = {0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+  Date date = {year, month, 1};
+  return days_in_month[month] + (month == 2 && Date_is_leap_year(&date));
+}
+
+/**
+ * @brief Converts a date to a serial day number
+ * @param date Pointer to a valid Date structure
+ * @return Days since 0000-12-31 (0001-01-01 is day 1)
+ */
+int Date_to_serial(const Date *date)
+{
+  int y = date->year - 1;
+  return 365 * y + y / 4 - y / 100 + y / 400 + Date_calc_day_of_year(date);
+}
+
+/**
+ * @brief Converts a serial day number back to a date
+ * @param serial Serial day (1 = 0001-01-01)
+ * @param date Pointer to Date structure to populate
+ */
+void Date_from_serial(int serial, Date *date)
+{
+  int n = serial - 1;
+  int n400 = n / 146097;
+  n %= 146097;
+  int n100 = n / 36524;
+  if (n100 == 4) // Last day of a 400-year cycle
+    n100 = 3;
+  n -= n100 * 36524;
+  int n4 = n / 1461;
+  n %= 1461;
+  int n1 = n / 365;
+  if (n1 == 4) // Last day of a 4-year cycle
+    n1 = 3;
+  n -= n1 * 365;
+
+  date->year = 400 * n400 + 100 * n100 + 4 * n4 + n1 + 1;
+  date->month = 1;
+  date->day = 1;
+
+  int leap = Date_is_leap_year(date);
+  int month = (n >> 5) + 1; // Never past the real month: months are <= 32 days
+  if (month < 12 && n >= days_before_month[leap][month + 1])
+    month++;
+  date->month = month;
+  date->day = n - days_before_month[leap][month] + 1;
+}
+
+/**
+ * @brief Adds a number of days to a date
+ * @param date Pointer to a valid Date structure
+ * @param days Number of days to add (negative to subtract)
+ * @param result Pointer to store the shifted date
+ * @return false if the result falls outside 0001-01-01..9999-12-31
+ */
+bool Date_add_days(const Date *date, int days, Date *result)
+{
+  static const Date last = {9999, 12, 31};
+  long serial = (long)Date_to_serial(date) + days;
+  if (serial < 1 || serial > Date_to_serial(&last))
+    return false;
+  Date_from_serial((int)serial, result);
+  return true;
+}
+
+/**
+ * @brief Starts a cursor at a date
+ * @param cursor Cursor to initialise
+ * @param date Pointer to a valid Date structure
+ */
+void DateCursor_init(DateCursor *cursor, const Date *date)
+{
+  cursor->date = *date;
+  cursor->serial = Date_to_serial(date);
+  cursor->day_of_year = Date_calc_day_of_year(date);
+  cursor->day_of_week = cursor->serial % 7;
+  cursor->leap = Date_is_leap_year(date);
+}
+
+/**
+ * @brief Moves a cursor forward by a number of days
+ * @param cursor Cursor to advance
+ * @param days Number of days (>= 0)
+ *
+ * Steps of up to a year carry through month and year boundaries using only
+ * additions and comparisons; longer jumps restart from the serial number.
+ */
+void DateCursor_advance(DateCursor *cursor, int days)
+{
+  static const int days_in_month[2][13] = {
+      {0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31},
+      {0, 31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31}};
+
+  if (days > 366)
+  {
+    Date date;
+    Date_from_serial(cursor->serial + days, &date);
+    DateCursor_init(cursor, &date);
+    return;
+  }
+
+  Date *d = &cursor->date;
+  cursor->serial += days;
+  cursor->day_of_week = (cursor->day_of_week + days) % 7;
+  cursor->day_of_year += days;
+  d->day += days;
+  while (d->day > days_in_month[cursor->leap][d->month])
+  {
+    d->day -= days_in_month[cursor->leap][d->month];
+    if (++d->month > 12)
+    {
+      cursor->day_of_year -= cursor->leap ? 366 : 365;
+      d->month = 1;
+      d->year++;
+      cursor->leap = Date_is_leap_year(d);
+    }
+  }
+}
+
+/**
+ * @brief Converts an ISO 8601 week date to a calendar date
+ * @param year ISO week-numbering year
+ * @param week Week number (1-53)
+ * @param weekday ISO weekday (1=Monday, 7=Sunday)
+ * @param date Pointer to store the calendar date
+ * @return false if the week or weekday does not exist
+ *
+ * Week 1 is the week containing 4 January; a year has 53 weeks when it
+ * starts on a Thursday, or on a Wednesday in a leap year.
+ */
+bool Date_from_iso_week(int year, int week, int weekday, Date *date)
+{
+  if (year < 1 || year > 9999 || week < 1 || weekday < 1 || weekday > 7)
+    return false;
+
+  Date jan1 = {year, 1, 1};
+  int jan1_dow = Date_year_start_dow[year % 400];
+  int weeks = 52 + (jan1_dow == 4 || (jan1_dow == 3 && Date_is_leap_year(&jan1)));
+  if (week > weeks)
+    return false;
+
+  Date jan4 = {year, 1, 4};
+  Date monday;
+  Date_from_serial(Date_to_serial(&jan4) - (Date_calc_day_of_week(&jan4) + 6) % 7, &monday);
+  return Date_add_days(&monday, (week - 1) * 7 + weekday - 1, date);
+}
+
+/**
+ * @brief Calculates the difference between a date and a reference date
+ * @param date Pointer to Date structure
+ * @param ref Pointer to the reference date
+ * @param buf Buffer to store the difference string
+ * @param size Size of buf
+ */
+void Date_calc_diff(const Date *date, const Date *ref, char *buf, size_t size)
+{
+  int diff_days = Date_to_serial(date) - Date_to_serial(ref);
+  int years, months, days;
+
+  if (diff_days < 0)
+  {
+    Date_calc_span(date, ref, &years, &months, &days);
+  }
+  else
+  {
+    Date_calc_span(ref, date, &years, &months, &days);
+  }
+
+  format_difference_string((diff_days > 0) - (diff_days < 0), years, months, days, buf, size);
+}
+
+/**
+ * @brief Calculates the calendar distance between two dates
+ * @param from Earlier date
+ * @param to Later (or equal) date
+ * @param years Output: whole years
+ * @param months Output: whole months after the years
+ * @param days Output: remaining days
+ *
+ * Counts whole calendar months first; a month whose end day does not exist
+ * (e.g. 31 Jan + 1 month) is clamped to the last day of that month.
+ */
+void Date_calc_span(const Date *from, const Date *to, int *years, int *months, int *days)
+{
+  int total = (to->year - from->year) * 12 + (to->month - from->month);
+  if (to->day < from->day)
+    total--;
+
+  Date anchor = {from->year + (from->month - 1 + total) / 12,
+                 (from->month - 1 + total) % 12 + 1,
+                 from->day};
+  int last_day = Date_days_in_month(anchor.year, anchor.month);
+  if (anchor.day > last_day)
+    anchor.day = last_day;
+
+  *years = total / 12;
+  *months = total % 12;
+  *days = Date_to_serial(to) - Date_to_serial(&anchor);
+}
+
+/**
+ * @brief Formats the date difference into human-readable string
+ * @param sign Direction of the difference (-1 past, 0 same day, 1 future)
+ * @param years Whole years
+ * @param months Whole months
+ * @param days Remaining days
+ * @param buf Buffer to store the formatted string
+ * @param size Size of buf
+ */
+static void format_difference_string(int sign, int years, int months, int days,
+                                     char *buf, size_t size)
+{
+  const char *direction = (sign < 0) ? "ago" : "after";
+
+  if (years > 0)
+  {
+    snprintf(buf, size, "%d years, %d months, %d days %s",
+             years, months, days, direction);
+  }
+  else if (months > 0)
+  {
+    snprintf(buf, size, "%d months, %d days %s", months, days, direction);
+  }
+  else if (sign != 0)
+  {
+    snprintf(buf, size, "%d days %s", days, direction);
+  }
+  else
+  {
+    snprintf(buf, size, "its today");
+  }
+}
+
+/**
+ * @brief Formats a date as YYYY-MM-DD
+ * @param date Pointer to Date structure
+ * @param buf Output buffer
+ * @param size Size of output buffer
+ */
+void Date_to_string(const Date *date, char *buf, size_t size)
+{
+  snprintf(buf, size, "%04d-%02d-%02d", date->year, date->month, date->day);
+}
+
+/* =========================== CLOCK ============================ */
+
+/**
+ * @brief Reads the system clock
+ * @param context Unused
+ * @return Seconds since 1970-01-01T00:00:00Z
+ */
+int64_t Date_system_time(void *context)
+{
+  (void)context;
+  return (int64_t)time(NULL);
+}
+
+/**
+ * @brief Converts a Unix timestamp to a calendar date
+ * @param seconds Seconds since 1970-01-01T00:00:00Z
+ * @param zone NULL or "UTC" for UTC, "local" for the host's zone, otherwise a TZ name
+ * @param date Output date
+ * @return true on success, false if the date falls outside 0001-9999
+ *
+ * UTC is pure arithmetic. Any other zone goes through localtime_r with TZ
+ * temporarily set, which touches the process environment: resolve zoned
+ * dates once, before starting threads. Unknown zone names fall back to UTC
+ * as libc does.
+ */
+bool Date_from_unix_time(int64_t seconds, const char *zone, Date *date)
+{
+  if (zone == NULL || strcmp(zone, "UTC") == 0)
+  {
+    int64_t days = seconds / 86400;
+    if (seconds % 86400 < 0)
+      days--;
+    int64_t serial = days + UNIX_EPOCH_SERIAL;
+    if (serial < 1 || serial >= CALENDAR_DAYS)
+      return false;
+    Date_from_serial((int)serial, date);
+    return true;
+  }
+
+  char saved[256];
+  const char *old_tz = getenv("TZ");
+  bool had_tz = old_tz != NULL && strlen(old_tz) < sizeof(saved);
+  if (had_tz)
+    strcpy(saved, old_tz);
+
+  if (strcmp(zone, "local") != 0)
+  {
+    setenv("TZ", zone, 1);
+  }
+  tzset();
+
+  time_t t = (time_t)seconds;
+  struct tm tm_now;
+  bool ok = localtime_r(&t, &tm_now) != NULL;
+
+  if (strcmp(zone, "local") != 0)
+  {
+    if (had_tz)
+      setenv("TZ", saved, 1);
+    else
+      unsetenv("TZ");
+    tzset();
+  }
+
+  if (!ok)
+    return false;
+  date->year = tm_now.tm_year + 1900;
+  date->month = tm_now.tm_mon + 1;
+  date->day = tm_now.tm_mday;
+  return Date_is_valid(date);
+}
+
+/**
+ * @brief Resolves "today" from a clock
+ * @param clock Time source and zone (NULL for the system clock in UTC)
+ * @param date Output date
+ * @return true on success, false if the clock is outside 0001-9999
+ *
+ * Not reentrant for a non-UTC zone: see Date_from_unix_time.
+ */
+bool DateClock_today(const DateClock *clock, Date *date)
+{
+  if (clock == NULL)
+    return Date_from_unix_time(Date_system_time(NULL), NULL, date);
+
+  DateClockFn now = clock->now ? clock->now : Date_system_time;
+  return Date_from_unix_time(now(clock->context), clock->zone, date);
+}
+
+/**
+ * @brief Reads the current date in UTC from the system clock
+ * @param date Pointer to Date structure to populate
+ */
+void Date_today(Date *date)
+{
+  if (!DateClock_today(NULL, date))
+  {
+    static const Date epoch = {1970, 1, 1};
+    *date = epoch;
+  }
+}
+
+/* ====================== DATE PARSING FUNCTIONS ================ */
+/**
+ * @brief Reads an unsigned decimal number
+ * @param p Cursor, advanced past the digits
+ * @param end End of input
+ * @param value Output value
+ * @return Number of digits read (0 if none, -1 if longer than 9 digits)
+ */
+static int scan_number(const char **p, const char *end, int *value)
+{
+  int digits = 0;
+  int v = 0;
+  while (*p < end && **p >= '0' && **p <= '9')
+  {
+    if (++digits > 9)
+      return -1;
+    v = v * 10 + (**p - '0');
+    (*p)++;
+  }
+  *value = v;
+  return digits;
+}
+
+/**
+ * @brief Reads exactly n digits
+ * @param p Input (not advanced)
+ * @param end End of input
+ * @param n Number of digits
+ * @param value Output value
+ * @return true if n digits were available
+ */
+static bool scan_fixed(const char *p, const char *end, int n, int *value)
+{
+  int v = 0;
+  if (end - p < n)
+    return false;
+  for (int i = 0; i < n; i++)
+  {
+    if (p[i] < '0' || p[i] > '9')
+      return false;
+    v = v * 10 + (p[i] - '0');
+  }
+  *value = v;
+  return true;
+}
+
+/**
+ * @brief Skips field separators (spaces plus at most one of - / , .)
+ * @param p Cursor
+ * @param end End of input
+ */
+static void skip_separator(const char **p, const char *end)
+{
+  while (*p < end && **p == ' ')
+    (*p)++;
+  if (*p < end && (**p == '-' || **p == '/' || **p == ',' || **p == '.'))
+    (*p)++;
+  while (*p < end && **p == ' ')
+    (*p)++;
+}
+
+/**
+ * @brief Parses the week part of an ISO week date (Www[-]D) after the year
+ * @param p Cursor positioned on the 'W', advanced past the weekday
+ * @param end End of input
+ * @param year ISO week-numbering year
+ * @param date Output date
+ * @return DATE_PARSE_OK or DATE_PARSE_BAD_WEEK
+ */
+static DateParseStatus scan_iso_week(const char **p, const char *end, int year, Date *date)
+{
+  int week, weekday;
+  const char *q = *p + 1;
+  if (!scan_fixed(q, end, 2, &week))
+    return DATE_PARSE_BAD_WEEK;
+  q += 2;
+  if (q < end && *q == '-')
+    q++;
+  if (!scan_fixed(q, end, 1, &weekday))
+    return DATE_PARSE_BAD_WEEK;
+  q++;
+
+  if (!Date_from_iso_week(year, week, weekday, date))
+    return DATE_PARSE_BAD_WEEK;
+  *p = q;
+  return DATE_PARSE_OK;
+}
+
+/**
+ * @brief Single-pass, allocation-free date parser with format detection
+ * @param str Input (need not be NUL-terminated)
+ * @param len Input length in bytes
+ * @param date Pointer to Date structure to populate
+ * @param error_pos Receives the byte offset of the error (may be NULL)
+ * @return DATE_PARSE_OK or the reason parsing failed
+ *
+ * Recognised forms (separators may be '-', '/', ',', '.' or spaces):
+ *   YYYY-MM-DD, YYYY MM DD, YYYYMMDD,
+ *   YYYY-Www-D, YYYYWwwD (ISO week date),
+ *   YYYY MONTH DD, DD MONTH YYYY, MONTH DD YYYY (month name or prefix).
+ * Only the syntax is checked; use Date_validate for calendar validity.
+ */
+DateParseStatus Date_parse(const char *str, size_t len, Date *date, size_t *error_pos)
+{
+  const char *p = str;
+  const char *end = str + len;
+  int value[3];
+  int digits[3];
+  int month_field = -1; // Index of the field given as a month name
+  int fields = 0;
+  bool week_date = false;
+  DateParseStatus status = DATE_PARSE_OK;
+
+  while (p < end && isspace((unsigned char)*p))
+    p++;
+  while (end > p && isspace((unsigned char)end[-1]))
+    end--;
+  if (p == end)
+  {
+    status = DATE_PARSE_EMPTY;
+    goto fail;
+  }
+
+  while (p < end && fields < 3)
+  {
+    if (*p >= '0' && *p <= '9')
+    {
+      digits[fields] = scan_number(&p, end, &value[fields]);
+      if (digits[fields] < 0)
+      {
+        status = DATE_PARSE_NUMBER_TOO_LONG;
+        goto fail;
+      }
+
+      if (fields == 0 && digits[0] == 8 && p == end)
+      {
+        date->year = value[0] / 10000;
+        date->month = value[0] / 100 % 100;
+        date->day = value[0] % 100;
+        return DATE_PARSE_OK;
+      }
+      if (fields == 0 && digits[0] == 4)
+      {
+        const char *w = p;
+        if (w < end && *w == '-')
+          w++;
+        if (w < end && (*w == 'W' || *w == 'w'))
+        {
+          p = w;
+          status = scan_iso_week(&p, end, value[0], date);
+          if (status != DATE_PARSE_OK)
+            goto fail;
+          week_date = true;
+          break;
+        }
+      }
+    }
+    else if (isalpha((unsigned char)*p))
+    {
+      const char *word = p;
+      while (p < end && isalpha((unsigned char)*p))
+        p++;
+      value[fields] = Date_month_from_name(word, (size_t)(p - word));
+      digits[fields] = 0;
+      if (value[fields] == 0 || month_field >= 0)
+      {
+        p = word;
+        status = DATE_PARSE_BAD_MONTH_NAME;
+        goto fail;
+      }
+      month_field = fields;
+    }
+    else
+    {
+      status = DATE_PARSE_BAD_CHAR;
+      goto fail;
+    }
+
+    fields++;
+    if (fields < 3)
+      skip_separator(&p, end);
+  }
+
+  if (p < end)
+  {
+    status = DATE_PARSE_TRAILING;
+    goto fail;
+  }
+  if (week_date)
+  {
+    return DATE_PARSE_OK; // Filled in by scan_iso_week
+  }
+  if (fields < 3)
+  {
+    status = DATE_PARSE_MISSING_FIELD;
+    goto fail;
+  }
+
+  if (month_field == 0) // MONTH DD YYYY
+  {
+    date->month = value[0];
+    date->day = value[1];
+    date->year = value[2];
+  }
+  else if (month_field == 1 && digits[0] != 4) // DD MONTH YYYY
+  {
+    date->day = value[0];
+    date->month = value[1];
+    date->year = value[2];
+  }
+  else // YYYY MM DD or YYYY MONTH DD
+  {
+    date->year = value[0];
+    date->month = value[1];
+    date->day = value[2];
+  }
+  return DATE_PARSE_OK;
+
+fail:
+  if (error_pos)
+    *error_pos = (size_t)(p - str);
+  return status;
+}
+
+/**
+ * @brief Returns a human-readable description of a parse status
+ * @param status Parse status
+ * @return Static message string
+ */
+const char *Date_parse_error_message(DateParseStatus status)
+{
+  switch (status)
+  {
+  case DATE_PARSE_OK:
+    return "No error";
+  case DATE_PARSE_EMPTY:
+    return "Empty date";
+  case DATE_PARSE_BAD_CHAR:
+    return "Unexpected character";
+  case DATE_PARSE_NUMBER_TOO_LONG:
+    return "Number too long";
+  case DATE_PARSE_BAD_MONTH_NAME:
+    return "Unknown month name";
+  case DATE_PARSE_BAD_WEEK:
+    return "Invalid ISO week date";
+  case DATE_PARSE_MISSING_FIELD:
+    return "Missing date field";
+  case DATE_PARSE_TRAILING:
+    return "Unexpected trailing characters";
+  }
+  return "Invalid date format";
+}
+
+/**
+ * @brief Looks up a month by (a prefix of) its English name
+ * @param name Month name, case insensitive, not necessarily NUL-terminated
+ * @param len Length of the name
+ * @return Month number (1-12), or 0 if no month starts with name
+ *
+ * Only the months sharing the first letter are compared; on an ambiguous
+ * prefix ("ma", "ju") the earlier month wins.
+ */
+int Date_month_from_name(const char *name, size_t len)
+{
+  static const char *months[] = {"january", "february", "march", "april", "may", "june",
+                                 "july", "august", "september", "october", "november", "december"};
+  // Candidate months for each initial letter, in calendar order
+  static const signed char by_letter[26][3] = {
+      ['a' - 'a'] = {4, 8}, ['d' - 'a'] = {12}, ['f' - 'a'] = {2},
+      ['j' - 'a'] = {1, 6, 7}, ['m' - 'a'] = {3, 5}, ['n' - 'a'] = {11},
+      ['o' - 'a'] = {10}, ['s' - 'a'] = {9}};
+
+  if (len == 0 || len > 9 || !isalpha((unsigned char)name[0]))
+    return 0;
+
+  const signed char *candidates = by_letter[tolower((unsigned char)name[0]) - 'a'];
+  for (int c = 0; c < 3 && candidates[c]; c++)
+  {
+    const char *full = months[candidates[c] - 1];
+    size_t i = 1;
+    while (i < len && full[i] && tolower((unsigned char)name[i]) == full[i])
+      i++;
+    if (i == len)
+      return candidates[c];
+  }
+  return 0;
+}
+/* ================ SIMD ISO DATE VALIDATION ===================== */
+
+/**
+ * @brief Parses and validates one fixed-width ISO date (scalar reference)
+ * @param s String with at least 11 readable bytes
+ * @param date Output date (zeroed when invalid)
+ * @return true if s is "YYYY-MM-DD" followed by '\0' or '\n' and is a valid date
+ */
+static bool parse_iso_fixed(const char *s, Date *date)
+{
+  static const Date invalid = {0, 0, 0};
+  int year, month, day;
+
+  if (!scan_fixed(s, s + 4, 4, &year) || s[4] != '-' ||
+      !scan_fixed(s + 5, s + 7, 2, &month) || s[7] != '-' ||
+      !scan_fixed(s + 8, s + 10, 2, &day) || (s[10] != '\0' && s[10] != '\n'))
+  {
+    *date = invalid;
+    return false;
+  }
+
+  date->year = year;
+  date->month = month;
+  date->day = day;
+  if (!Date_is_valid(date))
+  {
+    *date = invalid;
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Scalar fixed-width ISO date kernel
+ * @param strs Strings to check (each with at least 16 readable bytes)
+ * @param count Number of strings
+ * @param dates Output dates (zeroed when invalid)
+ * @param valid Output flags (1 = valid fixed-width date)
+ */
+void Date_parse_iso_batch_scalar(const char *const *strs, int count, Date *dates, unsigned char *valid)
+{
+  for (int i = 0; i < count; i++)
+  {
+    valid[i] = parse_iso_fixed(strs[i], &dates[i]);
+  }
+}
+
+#if DATE_SIMD_X86
+
+/**
+ * @brief Byte shuffle placing Y Y Y Y M M 0 0 D D 0 0 into one 128-bit lane
+ */
+#define ISO_DIGIT_SHUFFLE 0, 1, 2, 3, 5, 6, -1, -1, 8, 9, -1, -1, -1, -1, -1, -1
+
+/**
+ * @brief Expected byte classes per position: digits, dashes, terminator
+ */
+#define ISO_DIGIT_MASK -1, -1, -1, -1, 0, -1, -1, 0, -1, -1, 0, 0, 0, 0, 0, 0
+#define ISO_DASH_MASK 0, 0, 0, 0, -1, 0, 0, -1, 0, 0, 0, 0, 0, 0, 0, 0
+#define ISO_TERM_MASK 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -1, 0, 0, 0, 0, 0
+
+/**
+ * @brief Extra days over 28 per month, two bits per month (shifted by 2*month)
+ */
+#define ISO_MONTH_EXTRA 0x03BBEECCu
+
+/**
+ * @brief Scatters SoA year/month/day lanes back into Date structures
+ * @param dates Output dates (8 entries)
+ * @param valid Output flags (8 entries)
+ * @param y Years per lane
+ * @param m Months per lane
+ * @param d Days per lane
+ * @param lane_date Date index held by each lane
+ * @param ok Validity bit per lane
+ * @param lanes Number of lanes
+ */
+static void store_iso_lanes(Date *dates, unsigned char *valid, const int *y, const int *m,
+                            const int *d, const int *lane_date, unsigned ok, int lanes)
+{
+  for (int e = 0; e < lanes; e++)
+  {
+    int j = lane_date[e];
+    bool is_valid = (ok >> e) & 1;
+    valid[j] = is_valid;
+    dates[j].year = is_valid ? y[e] : 0;
+    dates[j].month = is_valid ? m[e] : 0;
+    dates[j].day = is_valid ? d[e] : 0;
+  }
+}
+
+/**
+ * @brief SSE4.1 fixed-width ISO date kernel (8 dates per iteration)
+ *
+ * Each date occupies one register while its digits are checked and packed
+ * to [year, month, day, 0]; four dates are then transposed so that the
+ * calendar checks run on four dates at once. Leftovers use the scalar path.
+ */
+__attribute__((target("sse4.1"))) void Date_parse_iso_batch_sse41(const char *const *strs, int count,
+                                                                  Date *dates, unsigned char *valid)
+{
+  const __m128i zero_char = _mm_set1_epi8('0');
+  const __m128i nine = _mm_set1_epi8(9);
+  const __m128i dash = _mm_set1_epi8('-');
+  const __m128i newline = _mm_set1_epi8('\n');
+  const __m128i digit_mask = _mm_setr_epi8(ISO_DIGIT_MASK);
+  const __m128i dash_mask = _mm_setr_epi8(ISO_DASH_MASK);
+  const __m128i term_mask = _mm_setr_epi8(ISO_TERM_MASK);
+  const __m128i shuffle = _mm_setr_epi8(ISO_DIGIT_SHUFFLE);
+  const __m128i tens = _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1);
+  const __m128i combine = _mm_setr_epi16(100, 1, 1, 0, 1, 0, 0, 0);
+  // Days per month for months 0-15 (0 for months that do not exist)
+  const __m128i month_days = _mm_setr_epi8(0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31, 0, 0, 0);
+  const __m128i three = _mm_set1_epi32(3);
+  const __m128i twelve = _mm_set1_epi32(12);
+  const __m128i two = _mm_set1_epi32(2);
+  const __m128i div100 = _mm_set1_epi32(5243); // (y * 5243) >> 19 == y / 100 for y <= 9999
+  const __m128i hundred = _mm_set1_epi32(100);
+  static const int lane_date[4] = {0, 1, 2, 3};
+
+  int i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    for (int half = 0; half < 8; half += 4)
+    {
+      __m128i fields[4];
+      unsigned format_ok = 0;
+
+      for (int k = 0; k < 4; k++)
+      {
+        __m128i raw = _mm_loadu_si128((const __m128i *)strs[i + half + k]);
+        __m128i digits = _mm_sub_epi8(raw, zero_char);
+        __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digits, nine), digits);
+        __m128i is_dash = _mm_cmpeq_epi8(raw, dash);
+        __m128i is_term = _mm_or_si128(_mm_cmpeq_epi8(raw, _mm_setzero_si128()),
+                                       _mm_cmpeq_epi8(raw, newline));
+        __m128i ok = _mm_or_si128(_mm_or_si128(_mm_and_si128(is_digit, digit_mask),
+                                               _mm_and_si128(is_dash, dash_mask)),
+                                  _mm_and_si128(is_term, term_mask));
+        format_ok |= (unsigned)((_mm_movemask_epi8(ok) & 0x7FF) == 0x7FF) << k;
+
+        __m128i packed = _mm_maddubs_epi16(_mm_shuffle_epi8(digits, shuffle), tens);
+        fields[k] = _mm_madd_epi16(packed, combine); // [year, month, day, 0]
+      }
+
+      // Transpose four [y, m, d, 0] rows into year/month/day vectors
+      __m128i t0 = _mm_unpacklo_epi32(fields[0], fields[1]);
+      __m128i t1 = _mm_unpacklo_epi32(fields[2], fields[3]);
+      __m128i t2 = _mm_unpackhi_epi32(fields[0], fields[1]);
+      __m128i t3 = _mm_unpackhi_epi32(fields[2], fields[3]);
+      __m128i year = _mm_unpacklo_epi64(t0, t1);
+      __m128i month = _mm_unpackhi_epi64(t0, t1);
+      __m128i day = _mm_unpacklo_epi64(t2, t3);
+
+      __m128i century = _mm_srli_epi32(_mm_mullo_epi32(year, div100), 19);
+      __m128i not_century = _mm_xor_si128(_mm_cmpeq_epi32(_mm_mullo_epi32(century, hundred), year),
+                                          _mm_set1_epi32(-1));
+      __m128i leap = _mm_and_si128(_mm_cmpeq_epi32(_mm_and_si128(year, three), _mm_setzero_si128()),
+                                   _mm_or_si128(not_century,
+                                                _mm_cmpeq_epi32(_mm_and_si128(century, three),
+                                                                _mm_setzero_si128())));
+      __m128i is_feb = _mm_cmpeq_epi32(month, two);
+      __m128i dim = _mm_shuffle_epi8(month_days, month);
+      dim = _mm_sub_epi32(dim, _mm_and_si128(leap, is_feb)); // Subtracting -1 adds the leap day
+
+      __m128i good = _mm_and_si128(_mm_cmpgt_epi32(year, _mm_setzero_si128()),
+                                   _mm_cmpgt_epi32(month, _mm_setzero_si128()));
+      good = _mm_andnot_si128(_mm_cmpgt_epi32(month, twelve), good);
+      good = _mm_and_si128(good, _mm_cmpgt_epi32(day, _mm_setzero_si128()));
+      good = _mm_andnot_si128(_mm_cmpgt_epi32(day, dim), good);
+
+      int y[4], m[4], d[4];
+      _mm_storeu_si128((__m128i *)y, year);
+      _mm_storeu_si128((__m128i *)m, month);
+      _mm_storeu_si128((__m128i *)d, day);
+      unsigned ok = format_ok & (unsigned)_mm_movemask_ps(_mm_castsi128_ps(good));
+      store_iso_lanes(dates + i + half, valid + i + half, y, m, d, lane_date, ok, 4);
+    }
+  }
+
+  Date_parse_iso_batch_scalar(strs + i, count - i, dates + i, valid + i);
+}
+
+/**
+ * @brief AVX2 fixed-width ISO date kernel (8 dates per iteration)
+ *
+ * Two dates share each 256-bit register (one per 128-bit lane) for the
+ * digit checks and packing; after an in-lane transpose every vector holds
+ * one field of all eight dates for the calendar checks.
+ */
+__attribute__((target("avx2"))) void Date_parse_iso_batch_avx2(const char *const *strs, int count,
+                                                               Date *dates, unsigned char *valid)
+{
+  const __m256i zero_char = _mm256_set1_epi8('0');
+  const __m256i nine = _mm256_set1_epi8(9);
+  const __m256i dash = _mm256_set1_epi8('-');
+  const __m256i newline = _mm256_set1_epi8('\n');
+  const __m256i digit_mask = _mm256_setr_epi8(ISO_DIGIT_MASK, ISO_DIGIT_MASK);
+  const __m256i dash_mask = _mm256_setr_epi8(ISO_DASH_MASK, ISO_DASH_MASK);
+  const __m256i term_mask = _mm256_setr_epi8(ISO_TERM_MASK, ISO_TERM_MASK);
+  const __m256i shuffle = _mm256_setr_epi8(ISO_DIGIT_SHUFFLE, ISO_DIGIT_SHUFFLE);
+  const __m256i tens = _mm256_set1_epi16(0x010A); // Byte pairs (10, 1)
+  const __m256i combine = _mm256_setr_epi16(100, 1, 1, 0, 1, 0, 0, 0, 100, 1, 1, 0, 1, 0, 0, 0);
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i three = _mm256_set1_epi32(3);
+  const __m256i two = _mm256_set1_epi32(2);
+  const __m256i twelve = _mm256_set1_epi32(12);
+  const __m256i div100 = _mm256_set1_epi32(5243); // (y * 5243) >> 19 == y / 100 for y <= 9999
+  const __m256i hundred = _mm256_set1_epi32(100);
+  const __m256i month_extra = _mm256_set1_epi32((int)ISO_MONTH_EXTRA);
+  const __m256i twenty_eight = _mm256_set1_epi32(28);
+  // After the transpose lane e holds date 2e (low half) or 2(e-4)+1 (high half)
+  static const int lane_date[8] = {0, 2, 4, 6, 1, 3, 5, 7};
+
+  int i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    __m256i fields[4];
+    unsigned format_ok = 0;
+
+    for (int k = 0; k < 4; k++)
+    {
+      __m256i raw = _mm256_inserti128_si256(
+          _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)strs[i + 2 * k])),
+          _mm_loadu_si128((const __m128i *)strs[i + 2 * k + 1]), 1);
+      __m256i digits = _mm256_sub_epi8(raw, zero_char);
+      __m256i is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(digits, nine), digits);
+      __m256i is_dash = _mm256_cmpeq_epi8(raw, dash);
+      __m256i is_term = _mm256_or_si256(_mm256_cmpeq_epi8(raw, zero), _mm256_cmpeq_epi8(raw, newline));
+      __m256i ok = _mm256_or_si256(_mm256_or_si256(_mm256_and_si256(is_digit, digit_mask),
+                                                   _mm256_and_si256(is_dash, dash_mask)),
+                                   _mm256_and_si256(is_term, term_mask));
+      unsigned bits = (unsigned)_mm256_movemask_epi8(ok);
+      format_ok |= (unsigned)((bits & 0x7FF) == 0x7FF) << (2 * k);
+      format_ok |= (unsigned)(((bits >> 16) & 0x7FF) == 0x7FF) << (2 * k + 1);
+
+      __m256i packed = _mm256_maddubs_epi16(_mm256_shuffle_epi8(digits, shuffle), tens);
+      fields[k] = _mm256_madd_epi16(packed, combine); // [year, month, day, 0] per lane
+    }
+
+    __m256i t0 = _mm256_unpacklo_epi32(fields[0], fields[1]);
+    __m256i t1 = _mm256_unpacklo_epi32(fields[2], fields[3]);
+    __m256i t2 = _mm256_unpackhi_epi32(fields[0], fields[1]);
+    __m256i t3 = _mm256_unpackhi_epi32(fields[2], fields[3]);
+    __m256i year = _mm256_unpacklo_epi64(t0, t1);
+    __m256i month = _mm256_unpackhi_epi64(t0, t1);
+    __m256i day = _mm256_unpacklo_epi64(t2, t3);
+
+    __m256i century = _mm256_srli_epi32(_mm256_mullo_epi32(year, div100), 19);
+    __m256i is_century = _mm256_cmpeq_epi32(_mm256_mullo_epi32(century, hundred), year);
+    __m256i leap = _mm256_and_si256(_mm256_cmpeq_epi32(_mm256_and_si256(year, three), zero),
+                                    _mm256_or_si256(_mm256_xor_si256(is_century, _mm256_set1_epi32(-1)),
+                                                    _mm256_cmpeq_epi32(_mm256_and_si256(century, three), zero)));
+    __m256i extra = _mm256_and_si256(_mm256_srlv_epi32(month_extra, _mm256_add_epi32(month, month)), three);
+    __m256i dim = _mm256_add_epi32(twenty_eight, extra);
+    dim = _mm256_sub_epi32(dim, _mm256_and_si256(leap, _mm256_cmpeq_epi32(month, two)));
+
+    __m256i good = _mm256_and_si256(_mm256_cmpgt_epi32(year, zero), _mm256_cmpgt_epi32(month, zero));
+    good = _mm256_andnot_si256(_mm256_cmpgt_epi32(month, twelve), good);
+    good = _mm256_and_si256(good, _mm256_cmpgt_epi32(day, zero));
+    good = _mm256_andnot_si256(_mm256_cmpgt_epi32(day, dim), good);
+
+    int y[8], m[8], d[8];
+    _mm256_storeu_si256((__m256i *)y, year);
+    _mm256_storeu_si256((__m256i *)m, month);
+    _mm256_storeu_si256((__m256i *)d, day);
+    unsigned lanes_ok = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(good));
+    unsigned ok = 0;
+    for (int e = 0; e < 8; e++)
+    {
+      ok |= (((lanes_ok >> e) & (format_ok >> lane_date[e])) & 1u) << e;
+    }
+    store_iso_lanes(dates + i, valid + i, y, m, d, lane_date, ok, 8);
+  }
+
+  Date_parse_iso_batch_scalar(strs + i, count - i, dates + i, valid + i);
+}
+
+#endif /* DATE_SIMD_X86 */
+
+/**
+ * @brief Picks the fastest fixed-width ISO kernel supported by this CPU
+ * @param name Receives the kernel name (may be NULL)
+ * @return Kernel function
+ */
+IsoBatchFn Date_select_iso_kernel(const char **name)
+{
+  IsoBatchFn fn = Date_parse_iso_batch_scalar;
+  const char *kernel = "scalar";
+#if DATE_SIMD_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+  {
+    fn = Date_parse_iso_batch_avx2;
+    kernel = "avx2";
+  }
+  else if (__builtin_cpu_supports("sse4.1"))
+  {
+    fn = Date_parse_iso_batch_sse41;
+    kernel = "sse4.1";
+  }
+#endif
+  if (name)
+    *name = kernel;
+  return fn;
+}
+
+/**
+ * @brief Parses and validates fixed-width YYYY-MM-DD strings in bulk
+ * @param strs Strings to check; each must have 16 readable bytes
+ * @param count Number of strings
+ * @param dates Output dates (zeroed when invalid)
+ * @param valid Output flags (1 = valid fixed-width date)
+ *
+ * A string is accepted only if it is exactly "YYYY-MM-DD" followed by '\0'
+ * or '\n' and is a valid Gregorian date. Anything else gets valid = 0 and
+ * should go through Date_parse for the full grammar and error message.
+ * Every kernel produces identical output.
+ */
+void Date_parse_iso_batch(const char *const *strs, int count, Date *dates, unsigned char *valid)
+{
+  static IsoBatchFn kernel = NULL;
+  IsoBatchFn fn = __atomic_load_n(&kernel, __ATOMIC_RELAXED);
+  if (fn == NULL)
+  {
+    fn = Date_select_iso_kernel(NULL);
+    __atomic_store_n(&kernel, fn, __ATOMIC_RELAXED);
+  }
+  fn(strs, count, dates, valid);
+}
+
+/* ====================== BUSINESS DAYS ========================= */
+
+/**
+ * @brief Initialises a calendar with Monday-Friday business days
+ * @param cal Calendar to initialise
+ */
+void BusinessCalendar_init(BusinessCalendar *cal)
+{
+  // Serial 1 (0001-01-01) is a Monday; serial % 7 gives 0=Sunday..6=Saturday
+  for (int w = 0; w < CALENDAR_WORDS; w++)
+  {
+    uint64_t bits = 0;
+    for (int b = 0; b < 64; b++)
+    {
+      int serial = w * 64 + b;
+      int dow = serial % 7;
+      if (serial >= 1 && serial < CALENDAR_DAYS && dow != 0 && dow != 6)
+        bits |= (uint64_t)1 << b;
+    }
+    cal->business[w] = bits;
+  }
+  BusinessCalendar_build_index(cal);
+}
+
+/**
+ * @brief Marks a date as a holiday
+ * @param cal Calendar to modify
+ * @param date Pointer to a valid Date structure
+ *
+ * Call BusinessCalendar_build_index after the last change.
+ */
+void BusinessCalendar_add_holiday(BusinessCalendar *cal, const Date *date)
+{
+  int serial = Date_to_serial(date);
+  cal->business[serial >> 6] &= ~((uint64_t)1 << (serial & 63));
+}
+
+/**
+ * @brief Recomputes the per-word prefix counts
+ * @param cal Calendar to index
+ */
+void BusinessCalendar_build_index(BusinessCalendar *cal)
+{
+  uint32_t total = 0;
+  for (int w = 0; w < CALENDAR_WORDS; w++)
+  {
+    cal->rank[w] = total;
+    total += (uint32_t)__builtin_popcountll(cal->business[w]);
+  }
+  cal->rank[CALENDAR_WORDS] = total;
+}
+
+/**
+ * @brief Checks whether a date is a business day
+ * @param cal Calendar
+ * @param date Pointer to a valid Date structure
+ * @return true for weekdays that are not holidays
+ */
+bool BusinessCalendar_is_business_day(const BusinessCalendar *cal, const Date *date)
+{
+  int serial = Date_to_serial(date);
+  return (cal->business[serial >> 6] >> (serial & 63)) & 1;
+}
+
+/**
+ * @brief Number of business days before a serial day
+ * @param cal Calendar
+ * @param serial Serial day (0..CALENDAR_DAYS)
+ * @return Count of business days with a smaller serial number
+ */
+static int calendar_rank(const BusinessCalendar *cal, int serial)
+{
+  uint64_t below = cal->business[serial >> 6] & (((uint64_t)1 << (serial & 63)) - 1);
+  return (int)cal->rank[serial >> 6] + __builtin_popcountll(below);
+}
+
+/**
+ * @brief Finds the k-th business day of the calendar
+ * @param cal Calendar
+ * @param k 1-based index of the business day
+ * @return Serial day, or 0 if there are fewer than k business days
+ */
+static int calendar_select(const BusinessCalendar *cal, int k)
+{
+  if (k < 1 || (uint32_t)k > cal->rank[CALENDAR_WORDS])
+    return 0;
+
+  // Last word whose prefix count is below k
+  int lo = 0;
+  int hi = CALENDAR_WORDS - 1;
+  while (lo < hi)
+  {
+    int mid = (lo + hi + 1) / 2;
+    if (cal->rank[mid] < (uint32_t)k)
+      lo = mid;
+    else
+      hi = mid - 1;
+  }
+
+  uint64_t bits = cal->business[lo];
+  for (int skip = k - (int)cal->rank[lo] - 1; skip > 0; skip--)
+    bits &= bits - 1; // Clear the lowest set bit
+  return lo * 64 + __builtin_ctzll(bits);
+}
+
+/**
+ * @brief Counts business days in [from, to)
+ * @param cal Calendar
+ * @param from First date (inclusive)
+ * @param to Last date (exclusive)
+ * @return Number of business days, negative if to is before from
+ *
+ * Constant time: two prefix-count lookups and two popcounts.
+ */
+int BusinessCalendar_count(const BusinessCalendar *cal, const Date *from, const Date *to)
+{
+  return calendar_rank(cal, Date_to_serial(to)) - calendar_rank(cal, Date_to_serial(from));
+}
+
+/**
+ * @brief Finds the date N business days after (or before) a date
+ * @param cal Calendar
+ * @param date Pointer to a valid Date structure
+ * @param days Business days to move; 0 rolls forward to the next business
+ *             day when date itself is not one
+ * @param result Pointer to store the resulting date
+ * @return false if the result falls outside the calendar
+ */
+bool BusinessCalendar_add(const BusinessCalendar *cal, const Date *date, int days, Date *result)
+{
+  int serial = Date_to_serial(date);
+  long k;
+  if (days > 0)
+    k = (long)calendar_rank(cal, serial + 1) + days;
+  else if (days < 0)
+    k = (long)calendar_rank(cal, serial) + days + 1;
+  else
+    k = (long)calendar_rank(cal, serial) + 1;
+
+  if (k < 1 || k > (long)cal->rank[CALENDAR_WORDS])
+    return false;
+  Date_from_serial(calendar_select(cal, (int)k), result);
+  return true;
+}
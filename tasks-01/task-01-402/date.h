@@ -0,0 +1,189 @@
+#ifndef DATE_H
+#define DATE_H
+
+/**
+ * @file date.h
+ * @brief Calendar core of the date calculator (libdate)
+ *
+ * Proleptic Gregorian dates from 0001-01-01 to 9999-12-31. Every function
+ * never allocates and never prints: failures are reported through return
+ * values (bool, DateStatus or DateParseStatus). Every function is also
+ * reentrant, except Date_from_unix_time and DateClock_today with a zone
+ * other than UTC: those set the process-wide TZ around localtime_r, so
+ * resolve zoned dates once, before starting threads.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define DATE_SIMD_X86 1 ///< SSE4.1/AVX2 kernels are compiled in (selected at runtime)
+#else
+#define DATE_SIMD_X86 0
+#endif
+
+#define CALENDAR_DAYS 3652060                      ///< Serial days 0..3652059 (up to 9999-12-31)
+#define CALENDAR_WORDS ((CALENDAR_DAYS + 63) / 64) ///< 64-day words in a calendar bitmap
+
+/**
+ * @struct Date
+ * @brief Structure representing a date with year, month, and day
+ */
+typedef struct
+{
+  int year;  ///< Year component of the date
+  int month; ///< Month component (1-12)
+  int day;   ///< Day component (1-31)
+} Date;
+
+/**
+ * @brief Result of Date_validate
+ */
+typedef enum
+{
+  DATE_OK = 0,               ///< Valid date
+  DATE_ERR_YEAR_NOT_POSITIVE, ///< Year below 1
+  DATE_ERR_YEAR_TOO_LARGE,    ///< Year above 9999
+  DATE_ERR_MONTH_RANGE,       ///< Month outside 1-12
+  DATE_ERR_DAY_RANGE,         ///< Day outside 1-31
+  DATE_ERR_DAY_30,            ///< Day 31 in a 30-day month
+  DATE_ERR_FEB_LEAP,          ///< February day above 29 in a leap year
+  DATE_ERR_FEB_COMMON         ///< February day above 28 in a common year
+} DateStatus;
+
+/**
+ * @brief Result of Date_parse
+ */
+typedef enum
+{
+  DATE_PARSE_OK = 0,          ///< Parsed successfully
+  DATE_PARSE_EMPTY,           ///< Input was empty or blank
+  DATE_PARSE_BAD_CHAR,        ///< Character that cannot start a field
+  DATE_PARSE_NUMBER_TOO_LONG, ///< Numeric field longer than 9 digits
+  DATE_PARSE_BAD_MONTH_NAME,  ///< Word that is not a month name
+  DATE_PARSE_BAD_WEEK,        ///< Malformed or out-of-range ISO week date
+  DATE_PARSE_MISSING_FIELD,   ///< Fewer than three fields
+  DATE_PARSE_TRAILING         ///< Characters after the last field
+} DateParseStatus;
+
+/**
+ * @brief Bulk fixed-width ISO date kernel (see Date_parse_iso_batch)
+ */
+typedef void (*IsoBatchFn)(const char *const *strs, int count, Date *dates, unsigned char *valid);
+
+/**
+ * @struct DateCursor
+ * @brief Date plus its derived fields, advanced incrementally
+ */
+typedef struct
+{
+  Date date;       ///< Current date
+  int serial;      ///< Serial day number
+  int day_of_year; ///< Day of year (1-366)
+  int day_of_week; ///< Day of week (0=Sunday)
+  bool leap;       ///< Current year is a leap year
+} DateCursor;
+
+/**
+ * @brief Time source: seconds since 1970-01-01T00:00:00Z
+ */
+typedef int64_t (*DateClockFn)(void *context);
+
+/**
+ * @struct DateClock
+ * @brief Injectable clock used to resolve "today"
+ *
+ * Lets callers pin "today" for reproducible runs (a fixed-time function)
+ * and choose the zone the date is taken in, instead of relying on the
+ * process TZ.
+ */
+typedef struct
+{
+  DateClockFn now;  ///< Time source (NULL for the system clock)
+  void *context;    ///< Passed to now
+  const char *zone; ///< NULL or "UTC", "local", or a TZ name such as "Europe/Berlin"
+} DateClock;
+
+/**
+ * @struct BusinessCalendar
+ * @brief Business-day bitmap indexed by serial day, with per-word prefix counts
+ *
+ * Fixed size (about 690 KB) so callers choose where it lives. Bit s of the
+ * bitmap is set when serial day s is a business day; rank[w] is the number
+ * of business days in words 0..w-1.
+ */
+typedef struct
+{
+  uint64_t business[CALENDAR_WORDS]; ///< Business-day bitmap
+  uint32_t rank[CALENDAR_WORDS + 1]; ///< Business days before each word
+} BusinessCalendar;
+
+/* Validation */
+DateStatus Date_validate(const Date *date);          // Checks date validity
+bool Date_is_valid(const Date *date);                // Date_validate(date) == DATE_OK
+const char *Date_status_message(DateStatus status);  // Validation status description
+bool Date_is_leap_year(const Date *date);            // Leap year checker
+
+/* Lookup tables */
+extern const unsigned char Date_year_start_dow[400]; // Weekday of 1 Jan per year % 400
+
+/* Core calculations */
+int Date_calc_day_of_year(const Date *date);    // Returns day number (1-366)
+int Date_calc_day_of_week(const Date *date);    // Returns weekday (0=Sun, 6=Sat)
+int Date_weekday(int year, int month, int day); // Arithmetic weekday kernel (0=Sun)
+int Date_days_in_month(int year, int month);    // Days in a month (28-31)
+const char *Date_day_name(int dow);             // Weekday name (0=Sunday)
+
+/* Serial day numbers (1 = 0001-01-01) */
+int Date_to_serial(const Date *date);                                 // Date -> serial day
+void Date_from_serial(int serial, Date *date);                        // Serial day -> date
+bool Date_add_days(const Date *date, int days, Date *result);         // Shifts a date by N days
+bool Date_from_iso_week(int year, int week, int weekday, Date *date); // ISO week date -> date
+void Date_calc_span(const Date *from, const Date *to,
+                    int *years, int *months, int *days);              // Calendar y/m/d between dates
+void Date_calc_diff(const Date *date, const Date *ref,
+                    char *buf, size_t size);                          // "N months, M days after"
+void Date_today(Date *date);                                          // Current UTC date
+void Date_to_string(const Date *date, char *buf, size_t size);        // Formats YYYY-MM-DD
+
+/* Clock */
+int64_t Date_system_time(void *context);                              // time(NULL) as a DateClockFn
+bool Date_from_unix_time(int64_t seconds, const char *zone, Date *date); // Timestamp -> date in zone (non-UTC sets TZ)
+bool DateClock_today(const DateClock *clock, Date *date);             // "Today" from an injected clock (non-UTC sets TZ)
+
+/* Incremental iteration */
+void DateCursor_init(DateCursor *cursor, const Date *date); // Starts a cursor at date
+void DateCursor_advance(DateCursor *cursor, int days);      // Moves a cursor forward
+
+/* Parsing */
+DateParseStatus Date_parse(const char *str, size_t len, Date *date,
+                           size_t *error_pos);                // Reentrant, zero-copy parser
+const char *Date_parse_error_message(DateParseStatus status); // Parse status description
+int Date_month_from_name(const char *name, size_t len);       // Month name/prefix to 1-12
+
+/* Bulk fixed-width YYYY-MM-DD validation */
+void Date_parse_iso_batch(const char *const *strs, int count,
+                          Date *dates, unsigned char *valid);        // Runtime-dispatched kernel
+void Date_parse_iso_batch_scalar(const char *const *strs, int count,
+                                 Date *dates, unsigned char *valid); // Portable reference kernel
+#if DATE_SIMD_X86
+void Date_parse_iso_batch_sse41(const char *const *strs, int count,
+                                Date *dates, unsigned char *valid);  // 4 dates per vector
+void Date_parse_iso_batch_avx2(const char *const *strs, int count,
+                               Date *dates, unsigned char *valid);   // 8 dates per vector
+#endif
+IsoBatchFn Date_select_iso_kernel(const char **name);                // Best kernel for this CPU
+
+/* Business days */
+void BusinessCalendar_init(BusinessCalendar *cal);                          // Mon-Fri, no holidays
+void BusinessCalendar_add_holiday(BusinessCalendar *cal, const Date *date); // Marks a holiday
+void BusinessCalendar_build_index(BusinessCalendar *cal);                   // Rebuilds prefix counts
+bool BusinessCalendar_is_business_day(const BusinessCalendar *cal,
+                                      const Date *date);                    // Weekday and not a holiday
+int BusinessCalendar_count(const BusinessCalendar *cal, const Date *from,
+                           const Date *to);                                 // Business days in [from, to)
+bool BusinessCalendar_add(const BusinessCalendar *cal, const Date *date, int days,
+                          Date *result);                                    // N business days after date
+
+#endif /* DATE_H */
@@ -2,21 +2,18 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <string.h>
-#include <time.h>
 #include <ctype.h>
+#include <stdarg.h>
+#include <unistd.h>
+#include <omp.h>
 
-#define MAX_INPUT_LEN 256 ///< Maximum length for input strings
+#include "date.h"
+#include "server.h"
 
-/**
- * @struct Date
- * @brief Structure representing a date with year, month, and day
- */
-typedef struct
-{
-  int year;  ///< Year component of the date
-  int month; ///< Month component (1-12)
-  int day;   ///< Day component (1-31)
-} Date;
+#define MAX_INPUT_LEN 256         ///< Maximum length for input strings
+#define BATCH_BUFFER_SIZE (1 << 16) ///< Stdio buffer size used in batch mode
+#define BATCH_CHUNK_LINES 16384     ///< Lines read per batch chunk
+#define MAX_THREADS 16              ///< Maximum number of threads
 
 /**
  * @struct Flags
@@ -29,44 +26,88 @@ typedef struct
   bool day_of_week; ///< Calculate day of week flag
   bool day_of_year; ///< Calculate day of year flag
   bool date_diff;   ///< Calculate date difference flag
+  char *batch_file; ///< Batch input file ("-" for stdin)
+  int threads;      ///< Worker threads for batch mode
+  bool add;         ///< Shift the date by add_days flag
+  int add_days;     ///< Number of days to add (may be negative)
+  bool has_ref;     ///< Reference date given with --ref
+  Date ref;         ///< Reference date for --df (defaults to today)
+  char *tz;         ///< Zone "today" is taken in (NULL = UTC)
+  bool has_today;   ///< "Today" pinned with --today
+  Date today;       ///< Pinned value of "today"
+  bool repl;        ///< Answer line-protocol requests on stdin/stdout
+  char *serve_path; ///< Unix socket to serve the line protocol on
+  bool range;       ///< Enumerate a date range flag
+  Date range_start; ///< First date of --range
+  Date range_end;   ///< Last date of --range (inclusive)
+  int step;         ///< Step in days for --range
+  char *holiday_file; ///< Holiday list for business-day arithmetic
+  bool bd_add;      ///< Add business days flag
+  int bd_days;      ///< Number of business days to add (may be negative)
+  bool bd_count;    ///< Count business days flag
+  Date bd_end;      ///< End date (exclusive) for --bd-count
+  BusinessCalendar *calendar; ///< Loaded once when a --bd-* flag is used
   Date date;        ///< Date structure
 } Flags;
 
+/**
+ * @struct OutputBuffer
+ * @brief Growable per-thread text buffer used by batch mode
+ */
+typedef struct
+{
+  char *data; ///< Buffer contents (not NUL-terminated)
+  size_t len; ///< Bytes used
+  size_t cap; ///< Bytes allocated
+} OutputBuffer;
+
 /* Main execution handlers */
 void parse_args(int argc, char *argv[], Flags *flags); // CLI argument parser
 void handle_input(Flags *flags);                       // Top-level input processor
 void validate_and_process(Flags *flags);               // Validates and runs calculations
+void resolve_reference_date(Flags *flags);             // Resolves --ref or today once per run
+
+/* Batch mode */
+void process_batch(const Flags *flags);                                     // Streams dates from file or stdin
+int read_batch_chunk(FILE *in, char (*lines)[MAX_INPUT_LEN], bool *overlong); // Reads one chunk of lines
+void process_batch_line(const Flags *flags, char *line, const Date *parsed,
+                        OutputBuffer *out);                                  // Validates and calculates one row
+void buffer_printf(OutputBuffer *buf, const char *fmt, ...);                 // Appends formatted text
+
+/* Business days */
+BusinessCalendar *load_business_calendar(const char *filename);             // Reads a holiday file
+void print_business_days(const Flags *flags);                               // Prints --bd-* results
+
+/* Server mode */
+void run_server(const Flags *flags); // Serves --repl or --serve until EOF/signal
+
+/* Range mode */
+void process_range(const Flags *flags);                          // Prints one row per date in range
+static char *write_range_row(char *p, const DateCursor *cursor); // Formats a row without printf
 
 /* Interactive input handling */
 void handle_prompt(Flags *flags, char *input, size_t size); // Shows input prompt
 void process_input(Flags *flags, const char *input);        // Processes user input
 void parse_year_day_input(Flags *flags, const char *input); // Parses YYYY DD format
+bool read_number_field(const char **p, int *value);         // Reads up to 9 digits
 void convert_month_string(Flags *flags);                    // Converts month names to numbers
 
 /* Date parsing utilities */
-bool parse_data(const char *str, Date *date);      // Parses YYYY-MM-DD or YYYY MM DD
+bool parse_data(const char *str, Date *date);      // Parses any supported date format
+void format_parse_error(DateParseStatus status, size_t pos,
+                        char *buf, size_t size); // "<message> at column N"
 bool parse_int(const char *str, int *value);       // Safe string-to-int conversion
 void trim_whitespace(char *str);                   // Trims leading/trailing whitespace
 void month_sti(const char *month_str, int *month); // Month name to number (e.g., "january" → 1)
 
 /* Validation */
-bool Date_is_valid(const Date *date);          // Checks date validity
-static bool is_out_of_range(const Date *date); // Validates year/month/day ranges
-static bool is_gregorian(const Date *date);    // Checks month-specific day rules
-bool Date_is_leap_year(const Date *date);      // Leap year checker
-
-/* Core calculations */
-int Date_calc_day_of_year(const Date *date);           // Returns day number (1-366)
-int Date_calc_day_of_week(const Date *date);           // Returns weekday (0=Sun, 6=Sat)
-void Date_calc_diff(const Date *date, char *diff_str); // Calculates difference from today
-
-/* Calculation formatters */
-void format_difference_string(int diff_days, char *diff_str); // Formats time delta string
+bool validate_date(const Date *date); // Date_validate plus error message
 
 /* Result printers */
 void print_day_of_year(const Date *date); // Prints day-of-year result
 void print_day_of_week(const Date *date); // Prints weekday name
-void print_date_diff(const Date *date);   // Prints human-readable date difference
+void print_date_diff(const Date *date, const Date *ref); // Prints human-readable date difference
+void print_added_date(const Date *date, int days);        // Prints date shifted by N days
 void Date_print_error(const char *msg);   // Standardized error printer
 void print_help(void);                    // Displays CLI usage help
 
@@ -74,6 +115,14 @@ void print_help(void);                    // Displays CLI usage help
 bool handle_help_flag(const char *arg, Flags *flags);                 // Processes -h/--help
 bool handle_month_flag(int argc, char *argv[], int *i, Flags *flags); // Handles -m/--m
 bool handle_operation_flags(const char *arg, Flags *flags);           // Processes --dw/--dy/--df
+bool handle_batch_flag(int argc, char *argv[], int *i, Flags *flags); // Handles -b/--batch
+bool handle_ref_flag(int argc, char *argv[], int *i, Flags *flags);   // Handles --ref DATE
+bool handle_add_flag(int argc, char *argv[], int *i, Flags *flags);   // Handles --add N
+bool handle_threads_flag(int argc, char *argv[], int *i, Flags *flags); // Handles -t/--threads
+bool handle_range_flags(int argc, char *argv[], int *i, Flags *flags);  // Handles --range/--step
+bool handle_business_flags(int argc, char *argv[], int *i, Flags *flags); // Handles --holidays/--bd-*
+bool handle_clock_flags(int argc, char *argv[], int *i, Flags *flags);    // Handles --tz/--today
+bool handle_server_flags(int argc, char *argv[], int *i, Flags *flags);   // Handles --repl/--serve
 void handle_date_argument(const char *arg, Flags *flags);             // Fallback for date args
 
 /* ======================== MAIN FUNCTION ======================== */
@@ -86,7 +135,7 @@ void handle_date_argument(const char *arg, Flags *flags);             // Fallbac
  */
 int main(int argc, char *argv[])
 {
-  Flags flags = {0};
+  Flags flags = {.threads = 4, .step = 1};
   parse_args(argc, argv, &flags);
 
   if (flags.help)
@@ -95,6 +144,30 @@ int main(int argc, char *argv[])
     return 0;
   }
 
+  if (flags.repl || flags.serve_path)
+  {
+    run_server(&flags);
+    return 0;
+  }
+
+  resolve_reference_date(&flags);
+  if (flags.bd_add || flags.bd_count)
+  {
+    flags.calendar = load_business_calendar(flags.holiday_file);
+  }
+
+  if (flags.range)
+  {
+    process_range(&flags);
+    return 0;
+  }
+
+  if (flags.batch_file)
+  {
+    process_batch(&flags);
+    return 0;
+  }
+
   handle_input(&flags);
   validate_and_process(&flags);
 
@@ -123,7 +196,7 @@ void handle_input(Flags *flags)
  */
 void validate_and_process(Flags *flags)
 {
-  if (!Date_is_valid(&flags->date))
+  if (!validate_date(&flags->date))
   {
     Date_print_error("Invalid date");
     exit(EXIT_FAILURE);
@@ -141,15 +214,529 @@ void validate_and_process(Flags *flags)
 
   if (flags->date_diff)
   {
-    print_date_diff(&flags->date);
+    print_date_diff(&flags->date, &flags->ref);
+  }
+
+  if (flags->add)
+  {
+    print_added_date(&flags->date, flags->add_days);
+  }
+
+  if (flags->bd_add || flags->bd_count)
+  {
+    print_business_days(flags);
   }
 
-  if (!flags->day_of_year && !flags->day_of_week && !flags->date_diff)
+  if (!flags->day_of_year && !flags->day_of_week && !flags->date_diff && !flags->add &&
+      !flags->bd_add && !flags->bd_count)
   {
     printf("Date is valid\n");
   }
 }
 
+/**
+ * @brief Fixes the reference date used by --df
+ * @param flags Pointer to Flags structure
+ *
+ * Called once per run so that batch rows all use the same reference and
+ * no clock or time-zone lookups happen per date. "Today" is taken in UTC
+ * unless --tz names a zone, and --today pins it for reproducible output.
+ */
+void resolve_reference_date(Flags *flags)
+{
+  if (!flags->date_diff)
+    return;
+
+  if (!flags->has_ref && flags->has_today)
+  {
+    flags->ref = flags->today;
+  }
+  else if (!flags->has_ref)
+  {
+    DateClock clock = {Date_system_time, NULL, flags->tz};
+    if (!DateClock_today(&clock, &flags->ref))
+    {
+      Date_print_error("System clock is outside the supported date range");
+      exit(EXIT_FAILURE);
+    }
+    return;
+  }
+
+  if (!validate_date(&flags->ref))
+  {
+    Date_print_error("Invalid reference date");
+    exit(EXIT_FAILURE);
+  }
+}
+
+/* ======================== BATCH MODE ========================== */
+
+/**
+ * @brief Streams newline-delimited dates and prints one result line per input
+ * @param flags Pointer to Flags structure (operation flags and batch source)
+ *
+ * Each output line is the trimmed input followed by tab-separated results in
+ * the same order as the single-date mode (day of year, day of week,
+ * difference). Invalid rows are reported inline instead of aborting the run.
+ *
+ * Input is read in chunks of BATCH_CHUNK_LINES lines. Each thread handles a
+ * contiguous slice of the chunk and formats into its own buffer; the buffers
+ * are written in thread order, so output order always matches input order.
+ */
+void process_batch(const Flags *flags)
+{
+  bool from_stdin = strcmp(flags->batch_file, "-") == 0;
+  FILE *in = from_stdin ? stdin : fopen(flags->batch_file, "r");
+  if (in == NULL)
+  {
+    Date_print_error("Could not open batch file");
+    exit(EXIT_FAILURE);
+  }
+
+  setvbuf(in, NULL, _IOFBF, BATCH_BUFFER_SIZE);
+  setvbuf(stdout, NULL, _IOFBF, BATCH_BUFFER_SIZE);
+
+  char(*lines)[MAX_INPUT_LEN] = malloc(BATCH_CHUNK_LINES * sizeof(*lines));
+  bool *overlong = malloc(BATCH_CHUNK_LINES * sizeof(*overlong));
+  const char **line_ptrs = malloc(BATCH_CHUNK_LINES * sizeof(*line_ptrs));
+  Date *fast_dates = malloc(BATCH_CHUNK_LINES * sizeof(*fast_dates));
+  unsigned char *fast_valid = malloc(BATCH_CHUNK_LINES * sizeof(*fast_valid));
+  OutputBuffer *buffers = calloc(flags->threads, sizeof(*buffers));
+  if (lines == NULL || overlong == NULL || line_ptrs == NULL || fast_dates == NULL ||
+      fast_valid == NULL || buffers == NULL)
+  {
+    Date_print_error("Out of memory");
+    exit(EXIT_FAILURE);
+  }
+
+  int count;
+  while ((count = read_batch_chunk(in, lines, overlong)) > 0)
+  {
+    int team = 1; // The runtime may grant fewer threads than asked for
+
+#pragma omp parallel num_threads(flags->threads)
+    {
+      int tid = omp_get_thread_num();
+      int nth = omp_get_num_threads();
+#pragma omp single nowait
+      team = nth;
+      int first = (int)((long)count * tid / nth);
+      int last = (int)((long)count * (tid + 1) / nth);
+      OutputBuffer *out = &buffers[tid];
+
+      // Fast path: plain YYYY-MM-DD rows are validated in bulk with SIMD
+      for (int i = first; i < last; i++)
+      {
+        line_ptrs[i] = lines[i];
+      }
+      Date_parse_iso_batch(line_ptrs + first, last - first, fast_dates + first, fast_valid + first);
+
+      out->len = 0;
+      for (int i = first; i < last; i++)
+      {
+        if (overlong[i])
+        {
+          buffer_printf(out, "\tinvalid\tLine too long\n");
+          continue;
+        }
+        process_batch_line(flags, lines[i], fast_valid[i] ? &fast_dates[i] : NULL, out);
+      }
+    }
+
+    for (int t = 0; t < team; t++)
+    {
+      fwrite(buffers[t].data, 1, buffers[t].len, stdout);
+    }
+  }
+
+  if (ferror(in))
+  {
+    Date_print_error("Failed to read batch input");
+  }
+  if (!from_stdin)
+  {
+    fclose(in);
+  }
+  fflush(stdout);
+
+  for (int t = 0; t < flags->threads; t++)
+  {
+    free(buffers[t].data);
+  }
+  free(buffers);
+  free(fast_valid);
+  free(fast_dates);
+  free(line_ptrs);
+  free(overlong);
+  free(lines);
+}
+
+/**
+ * @brief Reads up to BATCH_CHUNK_LINES lines into fixed-size slots
+ * @param in Input stream
+ * @param lines Line slots
+ * @param overlong Set for lines that did not fit into a slot
+ * @return Number of lines read (0 at end of input)
+ */
+int read_batch_chunk(FILE *in, char (*lines)[MAX_INPUT_LEN], bool *overlong)
+{
+  int count = 0;
+  while (count < BATCH_CHUNK_LINES && fgets(lines[count], MAX_INPUT_LEN, in) != NULL)
+  {
+    size_t len = strlen(lines[count]);
+    overlong[count] = len == MAX_INPUT_LEN - 1 && lines[count][len - 1] != '\n';
+    if (overlong[count])
+    {
+      // Discard the rest of an overlong line so it still yields a single row
+      int c;
+      while ((c = fgetc(in)) != EOF && c != '\n')
+        ;
+    }
+    count++;
+  }
+  return count;
+}
+
+/**
+ * @brief Validates one batch row and appends its result line
+ * @param flags Pointer to Flags structure
+ * @param line Input line (modified in place by trimming)
+ * @param parsed Date already validated by the fixed-width fast path, or NULL
+ * @param out Output buffer
+ */
+void process_batch_line(const Flags *flags, char *line, const Date *parsed, OutputBuffer *out)
+{
+  Date date = {0};
+
+  if (parsed)
+  {
+    line[10] = '\0'; // Drop the newline after YYYY-MM-DD
+    date = *parsed;
+  }
+  else
+  {
+    while (isspace((unsigned char)*line))
+      line++;
+    size_t len = strlen(line);
+    while (len > 0 && isspace((unsigned char)line[len - 1]))
+      line[--len] = '\0';
+
+    const char *error = NULL;
+    char parse_error[64];
+    size_t error_pos = 0;
+    DateParseStatus status = Date_parse(line, len, &date, &error_pos);
+    if (status != DATE_PARSE_OK)
+    {
+      format_parse_error(status, error_pos, parse_error, sizeof(parse_error));
+      error = parse_error;
+    }
+    else
+    {
+      DateStatus validity = Date_validate(&date);
+      if (validity != DATE_OK)
+        error = Date_status_message(validity);
+    }
+
+    if (error)
+    {
+      buffer_printf(out, "%s\tinvalid\t%s\n", line, error);
+      return;
+    }
+  }
+
+  buffer_printf(out, "%s", line);
+  if (flags->day_of_year)
+  {
+    buffer_printf(out, "\t%d", Date_calc_day_of_year(&date));
+  }
+  if (flags->day_of_week)
+  {
+    buffer_printf(out, "\t%s", Date_day_name(Date_calc_day_of_week(&date)));
+  }
+  if (flags->date_diff)
+  {
+    char diff_str[100];
+    Date_calc_diff(&date, &flags->ref, diff_str, sizeof(diff_str));
+    buffer_printf(out, "\t%s", diff_str);
+  }
+  if (flags->add)
+  {
+    Date shifted;
+    char buf[16];
+    if (Date_add_days(&date, flags->add_days, &shifted))
+    {
+      Date_to_string(&shifted, buf, sizeof(buf));
+      buffer_printf(out, "\t%s", buf);
+    }
+    else
+    {
+      buffer_printf(out, "\tout of range");
+    }
+  }
+  if (flags->bd_add)
+  {
+    Date shifted;
+    char buf[16];
+    if (BusinessCalendar_add(flags->calendar, &date, flags->bd_days, &shifted))
+    {
+      Date_to_string(&shifted, buf, sizeof(buf));
+      buffer_printf(out, "\t%s", buf);
+    }
+    else
+    {
+      buffer_printf(out, "\tout of range");
+    }
+  }
+  if (flags->bd_count)
+  {
+    buffer_printf(out, "\t%d", BusinessCalendar_count(flags->calendar, &date, &flags->bd_end));
+  }
+  if (!flags->day_of_year && !flags->day_of_week && !flags->date_diff && !flags->add &&
+      !flags->bd_add && !flags->bd_count)
+  {
+    buffer_printf(out, "\tvalid");
+  }
+  buffer_printf(out, "\n");
+}
+
+/**
+ * @brief Appends formatted text to a growable output buffer
+ * @param buf Output buffer
+ * @param fmt printf-style format string
+ */
+void buffer_printf(OutputBuffer *buf, const char *fmt, ...)
+{
+  va_list args;
+  for (;;)
+  {
+    size_t avail = buf->cap - buf->len;
+    va_start(args, fmt);
+    int n = vsnprintf(buf->data ? buf->data + buf->len : NULL, avail, fmt, args);
+    va_end(args);
+    if (n < 0)
+      return;
+    if ((size_t)n < avail)
+    {
+      buf->len += n;
+      return;
+    }
+
+    size_t cap = buf->cap ? buf->cap * 2 : BATCH_BUFFER_SIZE;
+    while (cap - buf->len <= (size_t)n)
+      cap *= 2;
+    char *data = realloc(buf->data, cap);
+    if (data == NULL)
+    {
+      Date_print_error("Out of memory");
+      exit(EXIT_FAILURE);
+    }
+    buf->data = data;
+    buf->cap = cap;
+  }
+}
+
+/* ====================== BUSINESS DAYS ========================= */
+/**
+ * @brief Builds a business calendar from a holiday file
+ * @param filename File with one holiday per line ('#' starts a comment), or NULL
+ * @return Newly allocated calendar (never NULL; exits on error)
+ */
+BusinessCalendar *load_business_calendar(const char *filename)
+{
+  BusinessCalendar *cal = malloc(sizeof(*cal));
+  if (cal == NULL)
+  {
+    Date_print_error("Out of memory");
+    exit(EXIT_FAILURE);
+  }
+  BusinessCalendar_init(cal);
+  if (filename == NULL)
+    return cal;
+
+  FILE *file = fopen(filename, "r");
+  if (file == NULL)
+  {
+    Date_print_error("Could not open holiday file");
+    exit(EXIT_FAILURE);
+  }
+
+  char line[MAX_INPUT_LEN];
+  int line_no = 0;
+  while (fgets(line, sizeof(line), file) != NULL)
+  {
+    line_no++;
+    line[strcspn(line, "#\n")] = '\0';
+    size_t len = strlen(line);
+    while (len > 0 && isspace((unsigned char)line[len - 1]))
+      len--;
+    const char *p = line;
+    while (isspace((unsigned char)*p))
+      p++;
+    if (*p == '\0')
+      continue;
+
+    Date holiday;
+    size_t error_pos;
+    if (Date_parse(p, len - (size_t)(p - line), &holiday, &error_pos) != DATE_PARSE_OK ||
+        !Date_is_valid(&holiday))
+    {
+      char msg[MAX_INPUT_LEN];
+      snprintf(msg, sizeof(msg), "Invalid holiday on line %d of %s", line_no, filename);
+      Date_print_error(msg);
+      exit(EXIT_FAILURE);
+    }
+    BusinessCalendar_add_holiday(cal, &holiday);
+  }
+  fclose(file);
+
+  BusinessCalendar_build_index(cal);
+  return cal;
+}
+
+/**
+ * @brief Prints business-day results for the single-date mode
+ * @param flags Pointer to Flags structure (calendar already loaded)
+ */
+void print_business_days(const Flags *flags)
+{
+  if (flags->bd_add)
+  {
+    Date shifted;
+    char buf[16];
+    if (!BusinessCalendar_add(flags->calendar, &flags->date, flags->bd_days, &shifted))
+    {
+      Date_print_error("Resulting date is out of range");
+      exit(EXIT_FAILURE);
+    }
+    Date_to_string(&shifted, buf, sizeof(buf));
+    printf("Business date: %s\n", buf);
+  }
+  if (flags->bd_count)
+  {
+    printf("Business days: %d\n", BusinessCalendar_count(flags->calendar, &flags->date, &flags->bd_end));
+  }
+}
+
+/* ======================== SERVER MODE ========================= */
+
+/**
+ * @brief Runs the long-lived line-protocol server
+ * @param flags Pointer to Flags structure
+ *
+ * --ref or --today pins the default reference date of "diff"; otherwise
+ * "today" follows the clock in the --tz zone (UTC by default).
+ */
+void run_server(const Flags *flags)
+{
+  ServerContext ctx = {.clock = {Date_system_time, NULL, flags->tz}};
+
+  if (flags->has_ref || flags->has_today)
+  {
+    ctx.fixed_today = true;
+    ctx.today = flags->has_ref ? flags->ref : flags->today;
+    if (!validate_date(&ctx.today))
+    {
+      Date_print_error("Invalid reference date");
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  bool ok = flags->serve_path ? server_run_socket(&ctx, flags->serve_path)
+                              : server_run_stream(&ctx, STDIN_FILENO, STDOUT_FILENO);
+  if (!ok)
+  {
+    Date_print_error(flags->serve_path ? "Could not serve on socket" : "Failed to serve requests");
+    exit(EXIT_FAILURE);
+  }
+}
+
+/* ======================== RANGE MODE ========================== */
+
+/**
+ * @brief Prints every step-th date from range_start to range_end
+ * @param flags Pointer to Flags structure
+ *
+ * Each row is "YYYY-MM-DD<TAB>weekday<TAB>day of year<TAB>leap (0/1)".
+ * Rows are produced by a DateCursor, so every derived field is updated
+ * incrementally instead of being recomputed per date, and are formatted by
+ * hand into a large buffer that is flushed with fwrite.
+ */
+void process_range(const Flags *flags)
+{
+  if (!validate_date(&flags->range_start) || !validate_date(&flags->range_end))
+  {
+    Date_print_error("Invalid range");
+    exit(EXIT_FAILURE);
+  }
+
+  int last = Date_to_serial(&flags->range_end);
+  char *buffer = malloc(BATCH_BUFFER_SIZE);
+  if (buffer == NULL)
+  {
+    Date_print_error("Out of memory");
+    exit(EXIT_FAILURE);
+  }
+
+  DateCursor cursor;
+  DateCursor_init(&cursor, &flags->range_start);
+  char *p = buffer;
+  while (cursor.serial <= last)
+  {
+    if (p > buffer + BATCH_BUFFER_SIZE - 64)
+    {
+      fwrite(buffer, 1, (size_t)(p - buffer), stdout);
+      p = buffer;
+    }
+    p = write_range_row(p, &cursor);
+    if (last - cursor.serial < flags->step)
+      break;
+    DateCursor_advance(&cursor, flags->step);
+  }
+  fwrite(buffer, 1, (size_t)(p - buffer), stdout);
+  fflush(stdout);
+  free(buffer);
+}
+
+/**
+ * @brief Formats one range row
+ * @param p Output position (at least 64 bytes available)
+ * @param cursor Current cursor
+ * @return Position after the row
+ */
+static char *write_range_row(char *p, const DateCursor *cursor)
+{
+  const Date *d = &cursor->date;
+  p[0] = (char)('0' + d->year / 1000);
+  p[1] = (char)('0' + d->year / 100 % 10);
+  p[2] = (char)('0' + d->year / 10 % 10);
+  p[3] = (char)('0' + d->year % 10);
+  p[4] = '-';
+  p[5] = (char)('0' + d->month / 10);
+  p[6] = (char)('0' + d->month % 10);
+  p[7] = '-';
+  p[8] = (char)('0' + d->day / 10);
+  p[9] = (char)('0' + d->day % 10);
+  p[10] = '\t';
+  p += 11;
+
+  const char *name = Date_day_name(cursor->day_of_week);
+  size_t len = strlen(name);
+  memcpy(p, name, len);
+  p += len;
+  *p++ = '\t';
+
+  int doy = cursor->day_of_year;
+  if (doy >= 100)
+    *p++ = (char)('0' + doy / 100);
+  if (doy >= 10)
+    *p++ = (char)('0' + doy / 10 % 10);
+  *p++ = (char)('0' + doy % 10);
+  *p++ = '\t';
+  *p++ = cursor->leap ? '1' : '0';
+  *p++ = '\n';
+  return p;
+}
+
 /* ==================== DATE INPUT FUNCTIONS ==================== */
 
 /**
@@ -185,9 +772,13 @@ void process_input(Flags *flags, const char *input)
   }
   else
   {
-    if (!parse_data(input, &flags->date))
+    size_t error_pos;
+    DateParseStatus status = Date_parse(input, strlen(input), &flags->date, &error_pos);
+    if (status != DATE_PARSE_OK)
     {
-      Date_print_error("Invalid date format");
+      char msg[64];
+      format_parse_error(status, error_pos, msg, sizeof(msg));
+      Date_print_error(msg);
       exit(EXIT_FAILURE);
     }
   }
@@ -200,24 +791,45 @@ void process_input(Flags *flags, const char *input)
  */
 void parse_year_day_input(Flags *flags, const char *input)
 {
-  char copy[MAX_INPUT_LEN];
-  strncpy(copy, input, sizeof(copy));
+  const char *p = input;
 
-  char *token = strtok(copy, " -");
-  if (!token || !parse_int(token, &flags->date.year))
+  while (isspace((unsigned char)*p))
+    p++;
+  if (!read_number_field(&p, &flags->date.year))
   {
     Date_print_error("Invalid year");
     exit(EXIT_FAILURE);
   }
 
-  token = strtok(NULL, " -");
-  if (!token || !parse_int(token, &flags->date.day))
+  if (*p != '\0' && strchr(" -/,.", *p))
+    p++;
+  if (!read_number_field(&p, &flags->date.day))
   {
     Date_print_error("Invalid day");
     exit(EXIT_FAILURE);
   }
 }
 
+/**
+ * @brief Reads an unsigned decimal field of at most 9 digits
+ * @param p Cursor, advanced past the digits
+ * @param value Output value
+ * @return true if at least one and at most 9 digits were read
+ */
+bool read_number_field(const char **p, int *value)
+{
+  int digits = 0;
+  *value = 0;
+  while (isdigit((unsigned char)**p))
+  {
+    if (++digits > 9)
+      return false;
+    *value = *value * 10 + (**p - '0');
+    (*p)++;
+  }
+  return digits > 0;
+}
+
 /**
  * @brief Converts month string to numeric value
  * @param flags Pointer to Flags structure
@@ -250,23 +862,27 @@ void parse_args(int argc, char *argv[], Flags *flags)
       continue;
     if (handle_operation_flags(argv[i], flags))
       continue;
+    if (handle_batch_flag(argc, argv, &i, flags))
+      continue;
+    if (handle_ref_flag(argc, argv, &i, flags))
+      continue;
+    if (handle_add_flag(argc, argv, &i, flags))
+      continue;
+    if (handle_threads_flag(argc, argv, &i, flags))
+      continue;
+    if (handle_range_flags(argc, argv, &i, flags))
+      continue;
+    if (handle_business_flags(argc, argv, &i, flags))
+      continue;
+    if (handle_clock_flags(argc, argv, &i, flags))
+      continue;
+    if (handle_server_flags(argc, argv, &i, flags))
+      continue;
     handle_date_argument(argv[i], flags);
   }
 }
 
-/* ====================== DATE VALIDATION ======================= */
-
-/**
- * @brief Validates a Date structure
- * @param date Pointer to Date structure
- * @return true if date is valid, false otherwise
- */
-bool Date_is_valid(const Date *date)
-{
-  return is_out_of_range(date) && is_gregorian(date);
-}
-
-/* ====================== UTILITY FUNCTIONS ===================== */
+/* ====================== UTILITY FUNCTIONS ===================== */
 
 /**
  * @brief Trims whitespace from a string
@@ -286,31 +902,7 @@ void trim_whitespace(char *str)
   *(end + 1) = 0;
 }
 
-/* ==================== DATE CALCULATION FUNCTIONS =============== */
-
-/**
- * @brief Calculates the day of year for a given date
- * @param date Pointer to Date structure
- * @return Day of year (1-366)
- */
-int Date_calc_day_of_year(const Date *date)
-{
-  static const int daysInMonth[] = {0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
-  int dayOfYear = date->day;
-
-  for (int m = 1; m < date->month; m++)
-  {
-    dayOfYear += daysInMonth[m];
-  }
-
-  if (date->month > 2 && Date_is_leap_year(date))
-  {
-    dayOfYear += 1;
-  }
-
-  return dayOfYear;
-}
-
+/* ======================= RESULT PRINTERS ====================== */
 /**
  * @brief Prints the day of year in human-readable format
  * @param date Pointer to Date structure
@@ -320,131 +912,69 @@ void print_day_of_year(const Date *date)
   printf("Day of year: %d\n", Date_calc_day_of_year(date));
 }
 
-/**
- * @brief Calculates the day of week for a given date
- * @param date Pointer to Date structure
- * @return Day of week (0=Sunday, 6=Saturday)
- */
-int Date_calc_day_of_week(const Date *date)
-{
-  struct tm tm = {0};
-  tm.tm_year = date->year - 1900;
-  tm.tm_mon = date->month - 1;
-  tm.tm_mday = date->day;
-  tm.tm_hour = 0;
-  mktime(&tm);
-  return tm.tm_wday;
-}
-
 /**
  * @brief Prints the day of week in human-readable format
  * @param date Pointer to Date structure
  */
 void print_day_of_week(const Date *date)
 {
-  const char *days[] = {"Sunday", "Monday", "Tuesday", "Wednesday",
-                        "Thursday", "Friday", "Saturday"};
-  int dow = Date_calc_day_of_week(date);
-  printf("Day of week: %s\n", days[dow]);
+  printf("Day of week: %s\n", Date_day_name(Date_calc_day_of_week(date)));
 }
 
 /**
- * @brief Calculates and prints the difference between date and today
+ * @brief Calculates and prints the difference between date and a reference
  * @param date Pointer to Date structure
+ * @param ref Pointer to reference date (usually today)
  */
-void print_date_diff(const Date *date)
+void print_date_diff(const Date *date, const Date *ref)
 {
   char diff_str[100];
-  Date_calc_diff(date, diff_str);
+  Date_calc_diff(date, ref, diff_str, sizeof(diff_str));
   printf("Date difference: %s\n", diff_str);
 }
 
 /**
- * @brief Calculates the difference between a date and today
+ * @brief Prints the date shifted by a number of days
  * @param date Pointer to Date structure
- * @param diff_str Buffer to store the difference string
- */
-void Date_calc_diff(const Date *date, char *diff_str)
-{
-  time_t now = time(NULL);
-  struct tm tm_date = {0};
-
-  tm_date.tm_year = date->year - 1900;
-  tm_date.tm_mon = date->month - 1;
-  tm_date.tm_mday = date->day;
-  time_t target = mktime(&tm_date);
-
-  double diff_sec = difftime(target, now);
-  int diff_days = (int)(diff_sec / (60 * 60 * 24));
-
-  format_difference_string(diff_days, diff_str);
-}
-
-/**
- * @brief Formats the date difference into human-readable string
- * @param diff_days Number of days difference
- * @param diff_str Buffer to store the formatted string
+ * @param days Number of days to add (negative to subtract)
  */
-void format_difference_string(int diff_days, char *diff_str)
+void print_added_date(const Date *date, int days)
 {
-  char *direction = (diff_days < 0) ? "ago" : "after";
-  diff_days = abs(diff_days);
-
-  int years = diff_days / 365;
-  int months = (diff_days % 365) / 30;
-  int days = (diff_days % 365) % 30;
-
-  if (years > 0)
+  Date shifted;
+  char buf[16];
+  if (!Date_add_days(date, days, &shifted))
   {
-    sprintf(diff_str, "%d years, %d months, %d days %s",
-            years, months, days, direction);
-  }
-  else if (months > 0)
-  {
-    sprintf(diff_str, "%d months, %d days %s", months, days, direction);
-  }
-  else if (days > 0)
-  {
-    sprintf(diff_str, "%d days %s", days, direction);
-  }
-  else
-  {
-    sprintf(diff_str, "its today");
+    Date_print_error("Resulting date is out of range");
+    exit(EXIT_FAILURE);
   }
+  Date_to_string(&shifted, buf, sizeof(buf));
+  printf("Shifted date: %s\n", buf);
 }
 
-/* ====================== DATE PARSING FUNCTIONS ================ */
+/* ===================== PARSING HELPERS ======================== */
 
 /**
  * @brief Parses a date string into Date structure
- * @param str Input date string (YYYY MM DD or YYYY-MM-DD)
+ * @param str Input date string (any format accepted by Date_parse)
  * @param date Pointer to Date structure to populate
  * @return true if parsing succeeded, false otherwise
  */
 bool parse_data(const char *str, Date *date)
 {
-  char copy[MAX_INPUT_LEN];
-  strncpy(copy, str, sizeof(copy));
-  copy[sizeof(copy) - 1] = '\0';
-
-  char *token = strtok(copy, " -");
-  if (!token)
-    return false;
-  date->year = atoi(token);
-
-  token = strtok(NULL, " -");
-  if (!token)
-    return false;
-  date->month = atoi(token);
-
-  token = strtok(NULL, " -");
-  if (!token)
-    return false;
-  date->day = atoi(token);
-
-  return true;
+  return Date_parse(str, strlen(str), date, NULL) == DATE_PARSE_OK;
 }
 
+/**
+ * @brief Formats a parse error with its column for display
+ * @param status Parse status
+ * @param pos Byte offset of the error
+ * @param buf Output buffer
+ * @param size Size of output buffer
+ */
+void format_parse_error(DateParseStatus status, size_t pos, char *buf, size_t size)
+{
+  snprintf(buf, size, "%s at column %zu", Date_parse_error_message(status), pos + 1);
+}
 /**
  * @brief Parses an integer from string with validation
  * @param str Input string containing integer
@@ -470,115 +1000,27 @@ bool parse_int(const char *str, int *value)
  */
 void month_sti(const char *month_str, int *month)
 {
-  const char *months[] = {"january", "february", "march", "april", "may", "june",
-                          "july", "august", "september", "october", "november", "december"};
-
-  char lower[20];
-  strncpy(lower, month_str, sizeof(lower));
-  for (int i = 0; lower[i]; i++)
-  {
-    lower[i] = tolower(lower[i]);
-  }
-
-  for (int i = 0; i < 12; i++)
-  {
-    if (strstr(months[i], lower) == months[i])
-    {
-      *month = i + 1;
-      return;
-    }
-  }
-  *month = 0;
+  *month = Date_month_from_name(month_str, strlen(month_str));
 }
 
-/* ====================== VALIDATION FUNCTIONS ================== */
-
-/**
- * @brief Checks if a year is a leap year
- * @param date Pointer to Date structure
- * @return true if leap year, false otherwise
- */
-bool Date_is_leap_year(const Date *date)
-{
-  int year = date->year;
-  if (year % 400 == 0)
-    return true;
-  if (year % 100 == 0)
-    return false;
-  if (year % 4 == 0)
-    return true;
-  return false;
-}
+/* ====================== HELPER FUNCTIONS ====================== */
 
 /**
- * @brief Checks if date components are within valid ranges
+ * @brief Validates a date and reports the broken rule
  * @param date Pointer to Date structure
- * @return true if components are in range, false otherwise
+ * @return true if date is valid, false otherwise (message printed)
  */
-static bool is_out_of_range(const Date *date)
+bool validate_date(const Date *date)
 {
-  if (date->year < 1)
-  {
-    Date_print_error("Year must be positive");
-    return false;
-  }
-  if (date->month < 1 || date->month > 12)
-  {
-    Date_print_error("Month must be 1-12");
-    return false;
-  }
-  if (date->day < 1 || date->day > 31)
+  DateStatus status = Date_validate(date);
+  if (status != DATE_OK)
   {
-    Date_print_error("Day must be 1-31");
+    Date_print_error(Date_status_message(status));
     return false;
   }
   return true;
 }
 
-/**
- * @brief Validates date according to Gregorian calendar rules
- * @param date Pointer to Date structure
- * @return true if date is valid, false otherwise
- */
-static bool is_gregorian(const Date *date)
-{
-  switch (date->month)
-  {
-  case 4:
-  case 6:
-  case 9:
-  case 11:
-    if (date->day > 30)
-    {
-      Date_print_error("This month has maximum 30 days");
-      return false;
-    }
-    break;
-
-  case 2:
-    if (Date_is_leap_year(date))
-    {
-      if (date->day > 29)
-      {
-        Date_print_error("February has 29 days in a leap year");
-        return false;
-      }
-    }
-    else
-    {
-      if (date->day > 28)
-      {
-        Date_print_error("February has 28 days in a not leap year");
-        return false;
-      }
-    }
-    break;
-  }
-  return true;
-}
-
-/* ====================== HELPER FUNCTIONS ====================== */
-
 /**
  * @brief Prints an error message to stderr
  * @param msg Error message to print
@@ -653,6 +1095,245 @@ bool handle_operation_flags(const char *arg, Flags *flags)
   return false;
 }
 
+/**
+ * @brief Handles the --batch/-b command line flag
+ * @param argc Argument count
+ * @param argv Argument vector
+ * @param i Pointer to current argument index
+ * @param flags Pointer to Flags structure
+ * @return true if batch flag was processed
+ */
+bool handle_batch_flag(int argc, char *argv[], int *i, Flags *flags)
+{
+  if (strcmp(argv[*i], "--batch") == 0 || strcmp(argv[*i], "-b") == 0)
+  {
+    if (*i + 1 < argc)
+    {
+      flags->batch_file = argv[++*i];
+      return true;
+    }
+    Date_print_error("Missing batch file argument");
+    exit(EXIT_FAILURE);
+  }
+  return false;
+}
+
+/**
+ * @brief Handles the --ref command line flag
+ * @param argc Argument count
+ * @param argv Argument vector
+ * @param i Pointer to current argument index
+ * @param flags Pointer to Flags structure
+ * @return true if reference flag was processed
+ */
+bool handle_ref_flag(int argc, char *argv[], int *i, Flags *flags)
+{
+  if (strcmp(argv[*i], "--ref") == 0 || strcmp(argv[*i], "-r") == 0)
+  {
+    if (*i + 1 < argc && parse_data(argv[*i + 1], &flags->ref))
+    {
+      flags->has_ref = true;
+      ++*i;
+      return true;
+    }
+    Date_print_error("Missing or invalid reference date");
+    exit(EXIT_FAILURE);
+  }
+  return false;
+}
+
+/**
+ * @brief Handles the --add command line flag
+ * @param argc Argument count
+ * @param argv Argument vector
+ * @param i Pointer to current argument index
+ * @param flags Pointer to Flags structure
+ * @return true if add flag was processed
+ */
+bool handle_add_flag(int argc, char *argv[], int *i, Flags *flags)
+{
+  if (strcmp(argv[*i], "--add") == 0 || strcmp(argv[*i], "-a") == 0)
+  {
+    if (*i + 1 < argc && parse_int(argv[*i + 1], &flags->add_days))
+    {
+      flags->add = true;
+      ++*i;
+      return true;
+    }
+    Date_print_error("Missing or invalid day count");
+    exit(EXIT_FAILURE);
+  }
+  return false;
+}
+
+/**
+ * @brief Handles the --threads/-t command line flag
+ * @param argc Argument count
+ * @param argv Argument vector
+ * @param i Pointer to current argument index
+ * @param flags Pointer to Flags structure
+ * @return true if threads flag was processed
+ */
+bool handle_threads_flag(int argc, char *argv[], int *i, Flags *flags)
+{
+  if (strcmp(argv[*i], "--threads") == 0 || strcmp(argv[*i], "-t") == 0)
+  {
+    if (*i + 1 < argc && parse_int(argv[*i + 1], &flags->threads) &&
+        flags->threads >= 1 && flags->threads <= MAX_THREADS)
+    {
+      ++*i;
+      return true;
+    }
+    char msg[64];
+    snprintf(msg, sizeof(msg), "Thread count must be between 1 and %d", MAX_THREADS);
+    Date_print_error(msg);
+    exit(EXIT_FAILURE);
+  }
+  return false;
+}
+
+/**
+ * @brief Handles the --range START END and --step N command line flags
+ * @param argc Argument count
+ * @param argv Argument vector
+ * @param i Pointer to current argument index
+ * @param flags Pointer to Flags structure
+ * @return true if a range flag was processed
+ */
+bool handle_range_flags(int argc, char *argv[], int *i, Flags *flags)
+{
+  if (strcmp(argv[*i], "--range") == 0)
+  {
+    if (*i + 2 < argc && parse_data(argv[*i + 1], &flags->range_start) &&
+        parse_data(argv[*i + 2], &flags->range_end))
+    {
+      flags->range = true;
+      *i += 2;
+      return true;
+    }
+    Date_print_error("--range needs a start and an end date");
+    exit(EXIT_FAILURE);
+  }
+  if (strcmp(argv[*i], "--step") == 0)
+  {
+    if (*i + 1 < argc && parse_int(argv[*i + 1], &flags->step) && flags->step >= 1)
+    {
+      ++*i;
+      return true;
+    }
+    Date_print_error("Step must be a positive number of days");
+    exit(EXIT_FAILURE);
+  }
+  return false;
+}
+
+/**
+ * @brief Handles --holidays FILE, --bd-add N and --bd-count DATE
+ * @param argc Argument count
+ * @param argv Argument vector
+ * @param i Pointer to current argument index
+ * @param flags Pointer to Flags structure
+ * @return true if a business-day flag was processed
+ */
+bool handle_business_flags(int argc, char *argv[], int *i, Flags *flags)
+{
+  if (strcmp(argv[*i], "--holidays") == 0)
+  {
+    if (*i + 1 < argc)
+    {
+      flags->holiday_file = argv[++*i];
+      return true;
+    }
+    Date_print_error("Missing holiday file argument");
+    exit(EXIT_FAILURE);
+  }
+  if (strcmp(argv[*i], "--bd-add") == 0)
+  {
+    if (*i + 1 < argc && parse_int(argv[*i + 1], &flags->bd_days))
+    {
+      flags->bd_add = true;
+      ++*i;
+      return true;
+    }
+    Date_print_error("Missing or invalid business day count");
+    exit(EXIT_FAILURE);
+  }
+  if (strcmp(argv[*i], "--bd-count") == 0)
+  {
+    if (*i + 1 < argc && parse_data(argv[*i + 1], &flags->bd_end) && validate_date(&flags->bd_end))
+    {
+      flags->bd_count = true;
+      ++*i;
+      return true;
+    }
+    Date_print_error("Missing or invalid end date for --bd-count");
+    exit(EXIT_FAILURE);
+  }
+  return false;
+}
+
+/**
+ * @brief Handles the --tz and --today command line flags
+ * @param argc Argument count
+ * @param argv Argument vector
+ * @param i Pointer to current argument index
+ * @param flags Pointer to Flags structure
+ * @return true if a clock flag was processed
+ */
+bool handle_clock_flags(int argc, char *argv[], int *i, Flags *flags)
+{
+  if (strcmp(argv[*i], "--tz") == 0)
+  {
+    if (*i + 1 < argc && argv[*i + 1][0] != '\0')
+    {
+      flags->tz = argv[++*i];
+      return true;
+    }
+    Date_print_error("Missing time zone argument");
+    exit(EXIT_FAILURE);
+  }
+  if (strcmp(argv[*i], "--today") == 0)
+  {
+    if (*i + 1 < argc && parse_data(argv[*i + 1], &flags->today) && validate_date(&flags->today))
+    {
+      flags->has_today = true;
+      ++*i;
+      return true;
+    }
+    Date_print_error("Missing or invalid date for --today");
+    exit(EXIT_FAILURE);
+  }
+  return false;
+}
+
+/**
+ * @brief Handles the --repl and --serve command line flags
+ * @param argc Argument count
+ * @param argv Argument vector
+ * @param i Pointer to current argument index
+ * @param flags Pointer to Flags structure
+ * @return true if a server flag was processed
+ */
+bool handle_server_flags(int argc, char *argv[], int *i, Flags *flags)
+{
+  if (strcmp(argv[*i], "--repl") == 0)
+  {
+    flags->repl = true;
+    return true;
+  }
+  if (strcmp(argv[*i], "--serve") == 0)
+  {
+    if (*i + 1 < argc && argv[*i + 1][0] != '\0')
+    {
+      flags->serve_path = argv[++*i];
+      return true;
+    }
+    Date_print_error("Missing socket path argument");
+    exit(EXIT_FAILURE);
+  }
+  return false;
+}
+
 /**
  * @brief Handles date argument parsing
  * @param arg Current argument being processed
@@ -660,9 +1341,13 @@ bool handle_operation_flags(const char *arg, Flags *flags)
  */
 void handle_date_argument(const char *arg, Flags *flags)
 {
-  if (!parse_data(arg, &flags->date))
+  size_t error_pos;
+  DateParseStatus status = Date_parse(arg, strlen(arg), &flags->date, &error_pos);
+  if (status != DATE_PARSE_OK)
   {
-    Date_print_error("Invalid argument");
+    char msg[64];
+    format_parse_error(status, error_pos, msg, sizeof(msg));
+    Date_print_error(msg);
     exit(EXIT_FAILURE);
   }
 }
@@ -679,6 +1364,20 @@ void print_help()
   printf("  -m, --m MONTH  Set month by name (e.g. december)\n");
   printf("  -dw, --dw      Calculate day of week\n");
   printf("  -dy, --dy      Calculate day of year\n");
-  printf("  -df, --df      Calculate difference from today\n");
-  printf("\nDate format: YYYY MM DD or YYYY-MM-DD\n");
+  printf("  -df, --df      Calculate difference from today (or --ref date)\n");
+  printf("  -r, --ref DATE Reference date for --df instead of today\n");
+  printf("  --tz ZONE      Zone \"today\" is taken in (default UTC; \"local\" for the host zone)\n");
+  printf("  --today DATE   Use DATE as today (reproducible runs)\n");
+  printf("  -a, --add N    Add N days to the date (negative to subtract)\n");
+  printf("  -b, --batch FILE  Process one date per line from FILE (- for stdin)\n");
+  printf("  -t, --threads N   Worker threads for batch mode (1-%d)\n", MAX_THREADS);
+  printf("  --range START END Print every date in the range (weekday, day of year, leap)\n");
+  printf("  --step N          Step in days for --range (default 1)\n");
+  printf("  --bd-add N        Date N business days after the date (Mon-Fri minus holidays)\n");
+  printf("  --bd-count DATE   Business days from the date up to (not including) DATE\n");
+  printf("  --holidays FILE   Holiday list for --bd-add/--bd-count (one date per line)\n");
+  printf("  --repl            Answer requests (dw, dy, valid, diff, add) line by line on stdin\n");
+  printf("  --serve PATH      Answer the same requests on a Unix domain socket\n");
+  printf("\nDate formats: YYYY-MM-DD, YYYY MM DD, YYYYMMDD, YYYY-Www-D,\n");
+  printf("              YYYY MONTH DD, DD MONTH YYYY, MONTH DD YYYY\n");
 }
@@ -0,0 +1,514 @@
+#define _POSIX_C_SOURCE 200809L // sigaction, poll
+
+#include "server.h"
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <signal.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#define SERVER_INPUT_SIZE (1 << 16)   ///< Per-connection input buffer (longest request line)
+#define SERVER_OUTPUT_SIZE (1 << 18)  ///< Responses gathered before one write
+#define SERVER_MAX_RESPONSE 256       ///< Longest single response line
+#define SERVER_MAX_CLIENTS 64         ///< Concurrent socket connections
+#define SERVER_TODAY_REFRESH 900      ///< Seconds between "today" refreshes
+
+/**
+ * @struct ServerConnection
+ * @brief Buffered state of one client stream
+ */
+typedef struct
+{
+  int in_fd;                       ///< Descriptor requests are read from
+  int out_fd;                      ///< Descriptor responses are written to
+  size_t len;                      ///< Unanswered bytes in input
+  size_t out_len;                  ///< Response bytes in output
+  size_t out_sent;                 ///< Response bytes already written
+  bool discarding;                 ///< Skipping the rest of an overlong line
+  bool eof;                        ///< Input is exhausted
+  bool quit;                       ///< Client sent quit
+  char input[SERVER_INPUT_SIZE];   ///< Unanswered input
+  char output[SERVER_OUTPUT_SIZE]; ///< Responses not yet written
+} ServerConnection;
+
+/* Request handling */
+static size_t respond(char *out, size_t size, const char *fmt, ...); // Formats one response line
+static bool parse_date_arg(const char *arg, Date *date, char *out, size_t size,
+                           size_t *written);                        // Parses and validates a date
+static char *next_token(char **p);                                  // Splits off one word
+
+/* Connection handling */
+static void refresh_today(ServerContext *ctx);                            // Re-reads the clock when due
+static bool read_input(ServerConnection *conn);                           // Reads what is available
+static void answer_lines(const ServerContext *ctx, ServerConnection *conn); // Answers complete lines
+static bool flush_output(ServerConnection *conn);                         // Writes pending responses
+static bool pump(const ServerContext *ctx, ServerConnection *conn);       // Answers until blocked
+static bool connection_done(const ServerConnection *conn);                // Nothing left to do
+static void handle_stop_signal(int sig);                                  // Ends the socket loop
+
+static volatile sig_atomic_t stop_requested; ///< Set by SIGINT/SIGTERM
+
+/* ===================== REQUEST HANDLING ======================= */
+
+/**
+ * @brief Answers one request line
+ * @param ctx Server context
+ * @param line Request without its newline (modified in place)
+ * @param out Response buffer
+ * @param size Size of out (at least SERVER_MAX_RESPONSE)
+ * @param quit Set to true when the client asked to close the connection
+ * @return Bytes written to out, including the newline (0 for quit)
+ */
+size_t server_handle_line(const ServerContext *ctx, char *line, char *out, size_t size, bool *quit)
+{
+  char *p = line;
+  char *command = next_token(&p);
+  while (isspace((unsigned char)*p))
+    p++;
+  size_t rest_len = strlen(p);
+  while (rest_len > 0 && isspace((unsigned char)p[rest_len - 1]))
+    p[--rest_len] = '\0';
+
+  Date date, ref;
+  size_t written;
+
+  if (command == NULL)
+    return respond(out, size, "error Empty request");
+
+  if (strcmp(command, "quit") == 0)
+  {
+    *quit = true;
+    return 0;
+  }
+
+  if (strcmp(command, "dw") == 0 || strcmp(command, "dy") == 0 || strcmp(command, "valid") == 0)
+  {
+    if (!parse_date_arg(p, &date, out, size, &written))
+      return written;
+    if (command[1] == 'w')
+      return respond(out, size, "ok %s", Date_day_name(Date_calc_day_of_week(&date)));
+    if (command[1] == 'y')
+      return respond(out, size, "ok %d", Date_calc_day_of_year(&date));
+    return respond(out, size, "ok valid");
+  }
+
+  if (strcmp(command, "diff") == 0)
+  {
+    char *first = next_token(&p);
+    char *second = next_token(&p);
+    if (first == NULL || next_token(&p) != NULL)
+      return respond(out, size, "error diff takes one or two dates");
+    if (!parse_date_arg(first, &date, out, size, &written))
+      return written;
+    ref = ctx->today;
+    if (second && !parse_date_arg(second, &ref, out, size, &written))
+      return written;
+
+    char diff_str[100];
+    Date_calc_diff(&date, &ref, diff_str, sizeof(diff_str));
+    return respond(out, size, "ok %s", diff_str);
+  }
+
+  if (strcmp(command, "add") == 0)
+  {
+    // The day count is the last word; everything before it is the date
+    char *count = strrchr(p, ' ');
+    char *end;
+    long days = count ? strtol(count + 1, &end, 10) : 0;
+    if (count == NULL || end == count + 1 || *end != '\0' || days < -CALENDAR_DAYS || days > CALENDAR_DAYS)
+      return respond(out, size, "error add takes a date and a day count");
+    *count = '\0';
+    if (!parse_date_arg(p, &date, out, size, &written))
+      return written;
+
+    Date shifted;
+    char buf[16];
+    if (!Date_add_days(&date, (int)days, &shifted))
+      return respond(out, size, "error Resulting date is out of range");
+    Date_to_string(&shifted, buf, sizeof(buf));
+    return respond(out, size, "ok %s", buf);
+  }
+
+  return respond(out, size, "error Unknown command (use dw, dy, valid, diff, add or quit)");
+}
+
+/**
+ * @brief Formats one response line
+ * @param out Response buffer
+ * @param size Size of out
+ * @param fmt printf-style format, without the newline
+ * @return Bytes written, including the newline
+ */
+static size_t respond(char *out, size_t size, const char *fmt, ...)
+{
+  va_list args;
+  va_start(args, fmt);
+  int n = vsnprintf(out, size - 1, fmt, args);
+  va_end(args);
+
+  size_t len = n < 0 ? 0 : (size_t)n < size - 1 ? (size_t)n : size - 2;
+  out[len++] = '\n';
+  return len;
+}
+
+/**
+ * @brief Parses and validates a date argument
+ * @param arg Date text
+ * @param date Output date
+ * @param out Response buffer, receives the error on failure
+ * @param size Size of out
+ * @param written Bytes written to out on failure
+ * @return true if arg is a valid date
+ */
+static bool parse_date_arg(const char *arg, Date *date, char *out, size_t size, size_t *written)
+{
+  size_t error_pos = 0;
+  DateParseStatus status = Date_parse(arg, strlen(arg), date, &error_pos);
+  if (status != DATE_PARSE_OK)
+  {
+    *written = respond(out, size, "error %s at column %zu", Date_parse_error_message(status), error_pos + 1);
+    return false;
+  }
+  DateStatus validity = Date_validate(date);
+  if (validity != DATE_OK)
+  {
+    *written = respond(out, size, "error %s", Date_status_message(validity));
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Splits off the next whitespace-separated word
+ * @param p Cursor, advanced past the word and its terminator
+ * @return NUL-terminated word, or NULL at the end of the line
+ */
+static char *next_token(char **p)
+{
+  char *s = *p;
+  while (isspace((unsigned char)*s))
+    s++;
+  if (*s == '\0')
+  {
+    *p = s;
+    return NULL;
+  }
+
+  char *word = s;
+  while (*s && !isspace((unsigned char)*s))
+    s++;
+  if (*s)
+    *s++ = '\0';
+  *p = s;
+  return word;
+}
+
+/* ===================== CONNECTION HANDLING ==================== */
+
+/**
+ * @brief Re-resolves "today" when the cached value may be stale
+ * @param ctx Server context
+ *
+ * Called once per read, not per request.
+ */
+static void refresh_today(ServerContext *ctx)
+{
+  if (ctx->fixed_today)
+    return;
+
+  DateClockFn now_fn = ctx->clock.now ? ctx->clock.now : Date_system_time;
+  int64_t now = now_fn(ctx->clock.context);
+  if (now < ctx->today_until)
+    return;
+
+  DateClock_today(&ctx->clock, &ctx->today);
+  ctx->today_until = (now / SERVER_TODAY_REFRESH + 1) * SERVER_TODAY_REFRESH;
+}
+
+/**
+ * @brief Reads as much input as fits into the connection buffer
+ * @param conn Connection
+ * @return false on a read error
+ */
+static bool read_input(ServerConnection *conn)
+{
+  if (conn->len == SERVER_INPUT_SIZE - 1)
+    return true; // Full buffer: answer_lines reports the overlong line first
+
+  for (;;)
+  {
+    ssize_t n = read(conn->in_fd, conn->input + conn->len, SERVER_INPUT_SIZE - 1 - conn->len);
+    if (n > 0)
+    {
+      conn->len += (size_t)n;
+      return true;
+    }
+    if (n == 0)
+    {
+      conn->eof = true;
+      return true;
+    }
+    if (errno == EAGAIN || errno == EWOULDBLOCK)
+      return true;
+    if (errno != EINTR)
+      return false;
+  }
+}
+
+/**
+ * @brief Answers every complete buffered line while output has room
+ * @param ctx Server context
+ * @param conn Connection
+ *
+ * Lines that do not fit stay buffered until the output drains. At end of
+ * input an unterminated last line is still answered; a line longer than
+ * the input buffer gets an error and the rest of it is skipped.
+ */
+static void answer_lines(const ServerContext *ctx, ServerConnection *conn)
+{
+  size_t start = 0;
+
+  while (start < conn->len && !conn->quit &&
+         conn->out_len <= SERVER_OUTPUT_SIZE - SERVER_MAX_RESPONSE)
+  {
+    char *line = conn->input + start;
+    char *newline = memchr(line, '\n', conn->len - start);
+    bool full = start == 0 && conn->len == SERVER_INPUT_SIZE - 1;
+    if (newline == NULL && !conn->eof && !full)
+      break; // Incomplete line: keep it for the next read
+
+    size_t line_len = newline ? (size_t)(newline - line) : conn->len - start;
+    start += line_len + (newline != NULL);
+
+    if (conn->discarding)
+    {
+      conn->discarding = newline == NULL && !conn->eof;
+      continue;
+    }
+    if (newline == NULL && !conn->eof)
+    {
+      conn->discarding = true;
+      conn->out_len += respond(conn->output + conn->out_len, SERVER_MAX_RESPONSE,
+                               "error Request line too long");
+      continue;
+    }
+
+    line[line_len] = '\0';
+    if (line_len > 0 && line[line_len - 1] == '\r')
+      line[line_len - 1] = '\0';
+    conn->out_len += server_handle_line(ctx, line, conn->output + conn->out_len,
+                                        SERVER_MAX_RESPONSE, &conn->quit);
+  }
+
+  memmove(conn->input, conn->input + start, conn->len - start);
+  conn->len -= start;
+}
+
+/**
+ * @brief Writes pending responses
+ * @param conn Connection
+ * @return false if the peer went away
+ *
+ * On a non-blocking descriptor whatever does not fit stays pending and is
+ * retried when the descriptor becomes writable.
+ */
+static bool flush_output(ServerConnection *conn)
+{
+  while (conn->out_sent < conn->out_len)
+  {
+    ssize_t n = write(conn->out_fd, conn->output + conn->out_sent, conn->out_len - conn->out_sent);
+    if (n > 0)
+    {
+      conn->out_sent += (size_t)n;
+      continue;
+    }
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+      return true;
+    return false;
+  }
+  conn->out_len = conn->out_sent = 0;
+  return true;
+}
+
+/**
+ * @brief Answers buffered requests until input runs out or output blocks
+ * @param ctx Server context
+ * @param conn Connection
+ * @return false if the peer went away
+ *
+ * All responses gathered from one read go out in a single write, so
+ * pipelined requests cost one read and one write per batch, not per line.
+ * No new requests are answered while responses are pending, which pushes
+ * back on clients that send without reading.
+ */
+static bool pump(const ServerContext *ctx, ServerConnection *conn)
+{
+  for (;;)
+  {
+    size_t before = conn->len;
+    if (conn->out_len == 0)
+      answer_lines(ctx, conn);
+    if (!flush_output(conn))
+      return false;
+    if (conn->out_len > 0 || conn->len == before || conn->len == 0 || conn->quit)
+      return true;
+  }
+}
+
+/**
+ * @brief Checks whether a connection can be closed
+ * @param conn Connection
+ * @return true once every response has been written after quit or EOF
+ */
+static bool connection_done(const ServerConnection *conn)
+{
+  return conn->out_len == 0 && (conn->quit || (conn->eof && conn->len == 0));
+}
+
+/**
+ * @brief Serves requests from one stream until EOF or quit
+ * @param ctx Server context
+ * @param in_fd Descriptor requests are read from (e.g. stdin)
+ * @param out_fd Descriptor responses are written to (e.g. stdout)
+ * @return true on clean shutdown, false on an I/O or memory error
+ */
+bool server_run_stream(ServerContext *ctx, int in_fd, int out_fd)
+{
+  ServerConnection *conn = calloc(1, sizeof(ServerConnection));
+  if (conn == NULL)
+    return false;
+
+  conn->in_fd = in_fd;
+  conn->out_fd = out_fd;
+  bool ok = true;
+  while (ok && !connection_done(conn))
+  {
+    ok = (conn->eof || read_input(conn));
+    refresh_today(ctx);
+    ok = ok && pump(ctx, conn);
+  }
+
+  free(conn);
+  return ok;
+}
+
+/**
+ * @brief Stops the socket loop
+ * @param sig Signal number
+ */
+static void handle_stop_signal(int sig)
+{
+  (void)sig;
+  stop_requested = 1;
+}
+
+/**
+ * @brief Serves clients on a Unix domain socket until SIGINT or SIGTERM
+ * @param ctx Server context
+ * @param path Socket path (replaced if it exists, removed on exit)
+ * @return true on clean shutdown, false if the socket could not be set up
+ *
+ * Non-blocking connections are multiplexed with poll on a single thread: a
+ * request costs far less than a context switch, and a client that stops
+ * reading only stalls itself.
+ */
+bool server_run_socket(ServerContext *ctx, const char *path)
+{
+  struct sockaddr_un addr = {.sun_family = AF_UNIX};
+  if (strlen(path) >= sizeof(addr.sun_path))
+  {
+    errno = ENAMETOOLONG;
+    return false;
+  }
+  strcpy(addr.sun_path, path);
+
+  int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listener < 0)
+    return false;
+  unlink(path);
+  if (bind(listener, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(listener, SOMAXCONN) < 0)
+  {
+    close(listener);
+    return false;
+  }
+
+  struct sigaction action = {.sa_handler = handle_stop_signal};
+  sigemptyset(&action.sa_mask);
+  sigaction(SIGINT, &action, NULL);
+  sigaction(SIGTERM, &action, NULL);
+  signal(SIGPIPE, SIG_IGN);
+
+  struct pollfd fds[SERVER_MAX_CLIENTS + 1];
+  ServerConnection *conns[SERVER_MAX_CLIENTS + 1] = {NULL};
+  int count = 1;
+  fds[0].fd = listener;
+  fds[0].events = POLLIN;
+
+  while (!stop_requested)
+  {
+    if (poll(fds, (nfds_t)count, -1) < 0)
+    {
+      if (errno == EINTR)
+        continue;
+      break;
+    }
+
+    for (int i = count - 1; i >= 1; i--)
+    {
+      ServerConnection *conn = conns[i];
+      if (fds[i].revents == 0)
+        continue;
+
+      bool ok = conn->out_len > 0 || read_input(conn);
+      refresh_today(ctx);
+      ok = ok && pump(ctx, conn);
+      if (ok && !connection_done(conn))
+      {
+        fds[i].events = conn->out_len > 0 ? POLLOUT : POLLIN;
+        continue;
+      }
+
+      close(fds[i].fd);
+      free(conn);
+      fds[i] = fds[count - 1];
+      conns[i] = conns[count - 1];
+      count--;
+    }
+
+    if (fds[0].revents & POLLIN)
+    {
+      int client = accept(listener, NULL, NULL);
+      ServerConnection *conn = client >= 0 && count <= SERVER_MAX_CLIENTS ? calloc(1, sizeof(ServerConnection)) : NULL;
+      if (conn == NULL)
+      {
+        if (client >= 0)
+          close(client);
+        continue;
+      }
+      fcntl(client, F_SETFL, fcntl(client, F_GETFL) | O_NONBLOCK);
+      conn->in_fd = conn->out_fd = client;
+      fds[count].fd = client;
+      fds[count].events = POLLIN;
+      conns[count++] = conn;
+    }
+  }
+
+  for (int i = 1; i < count; i++)
+  {
+    close(fds[i].fd);
+    free(conns[i]);
+  }
+  close(listener);
+  unlink(path);
+  return true;
+}
@@ -0,0 +1,48 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+/**
+ * @file server.h
+ * @brief Long-lived line-protocol front end of the date calculator
+ *
+ * One request per line, one response line per request, in order:
+ *
+ *   dw DATE        -> ok Monday
+ *   dy DATE        -> ok 359
+ *   valid DATE     -> ok valid
+ *   diff A [B]     -> ok 7 days after    (A relative to B, default today)
+ *   add DATE N     -> ok 2024-01-31
+ *   quit           -> closes the connection
+ *
+ * Failures answer "error <message>". Every complete line received in one
+ * read is answered with a single write.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "date.h"
+
+/**
+ * @struct ServerContext
+ * @brief State shared by every connection
+ *
+ * "Today" is cached and refreshed from the clock at most once per
+ * 15 minutes (every UTC offset is a multiple of 15 minutes), so requests
+ * never query the clock themselves.
+ */
+typedef struct
+{
+  DateClock clock;     ///< Source of "today"
+  bool fixed_today;    ///< today was pinned (--today/--ref) and never refreshed
+  Date today;          ///< Default reference date for diff
+  int64_t today_until; ///< Clock value at which today must be refreshed
+} ServerContext;
+
+bool server_run_stream(ServerContext *ctx, int in_fd, int out_fd); // Serves one stream until EOF
+bool server_run_socket(ServerContext *ctx, const char *path);      // Serves a Unix socket until SIGINT/SIGTERM
+size_t server_handle_line(const ServerContext *ctx, char *line,
+                          char *out, size_t size, bool *quit);     // Answers one request
+
+#endif /* SERVER_H */
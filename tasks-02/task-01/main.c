@@ -1,184 +1,2162 @@
+#define _GNU_SOURCE // sched_setaffinity, CPU_* macros
 #include <stdio.h>
 #include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
-#include <math.h>
+#include <errno.h>
+#include <limits.h>
 #include <omp.h>
+#include <sched.h>
 
-#define MAX_RANGE 1000000000000000000LL // 10^18 (maximum supported range)
-#define MAX_INPUT_LEN 256               // Maximum length for user input
-#define MAX_THREADS 16                  // Maximum number of threads
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define ARMSTRONG_SIMD_X86 1 // AVX2 scan kernel is compiled in (selected at runtime)
+#else
+#define ARMSTRONG_SIMD_X86 0
+#endif
+
+/* 128-bit arithmetic for --digits; build with -DARMSTRONG_NO_INT128 to force the fallback */
+#if defined(__SIZEOF_INT128__) && !defined(ARMSTRONG_NO_INT128)
+#define ARMSTRONG_INT128 1
+typedef unsigned __int128 WideUint; ///< Native 128-bit unsigned integer
+#else
+#define ARMSTRONG_INT128 0
+/**
+ * @brief Fixed-width 128-bit unsigned integer (two 64-bit halves)
+ */
+typedef struct
+{
+  unsigned long long high; ///< Upper 64 bits
+  unsigned long long low;  ///< Lower 64 bits
+} WideUint;
+#endif
+
+#define MAX_RANGE LLONG_MAX // 9223372036854775807 (maximum supported range)
+#define MAX_DIGITS 19       // Digits of MAX_RANGE
+#define MAX_INPUT_LEN 256   // Maximum length for user input
+#define BLOCK_DIGITS 4      // Low digits covered by one scan block
+#define BLOCK_SIZE 10000    // Numbers per scan block (10^BLOCK_DIGITS)
+#define MIN_BASE 2          // Smallest supported base
+#define MAX_BASE 36         // Largest supported base (digits 0-9, a-z)
+#define MAX_POWER 63        // Largest fixed exponent for --power
+#define MAX_BASE_DIGITS 63  // Digits of MAX_RANGE in base 2
+#define MAX_WIDE_DIGITS 39  // Longest narcissistic numbers (base 10)
+#define MIN_CHUNK_BLOCKS 16      // Smallest scan chunk (first chunk of every thread)
+#define MAX_CHUNK_BLOCKS 65536   // Largest scan chunk
+#define TARGET_CHUNK_SECONDS 0.01 // Run time aimed at per chunk
+#define CACHE_LINE 64       // Padding for per-thread counters
+#define CHECKPOINT_MAGIC "armstrong-checkpoint 1"
+#define BENCH_MIN_SECONDS 0.2     // Repeat short benchmark runs until they total this long
+
+/**
+ * @brief Search algorithm
+ */
+typedef enum
+{
+  METHOD_MULTISET, ///< Enumerate digit multisets (default)
+  METHOD_SCAN      ///< Test every integer in the range
+} SearchMethod;
+
+/**
+ * @brief Range scan kernel
+ */
+typedef enum
+{
+  KERNEL_AUTO,   ///< Best kernel supported by the CPU
+  KERNEL_SCALAR, ///< Portable, four candidates per iteration
+  KERNEL_AVX2,   ///< Eight candidates per iteration
+  KERNEL_ODOMETER ///< Incremental digit-power sum over per-thread subranges
+} ScanKernel;
+
+/**
+ * @brief Growable array of found numbers (one per thread while searching)
+ */
+typedef struct
+{
+  unsigned long long *items; ///< Found numbers
+  size_t count;              ///< Numbers stored
+  size_t capacity;           ///< Allocated slots
+} ResultVector;
+
+/**
+ * @brief Checkpoint and progress options of the block scan
+ */
+typedef struct
+{
+  const char *checkpoint_path; ///< State file (NULL = no checkpoints)
+  double checkpoint_interval;  ///< Seconds between checkpoints
+  bool resume;                 ///< Continue from checkpoint_path
+  bool progress;               ///< Live progress line on stderr
+} ScanOptions;
+
+/**
+ * @brief Benchmark report format
+ */
+typedef enum
+{
+  FORMAT_TEXT, ///< Aligned table
+  FORMAT_CSV,  ///< One header line, one line per run
+  FORMAT_JSON  ///< Array of objects
+} ReportFormat;
+
+/**
+ * @brief Finished run of scan blocks (checkpoint bookkeeping)
+ */
+typedef struct
+{
+  long long first; ///< First block
+  long long last;  ///< Last block
+} BlockRange;
+
+/**
+ * @brief Finished chunks above the checkpoint watermark, keyed by first block
+ *
+ * Open addressing with linear probing; a slot whose first is -1 is empty.
+ * Inserting a chunk and taking the one that starts at the watermark are
+ * both expected O(1), however many chunks are in flight.
+ */
+typedef struct
+{
+  BlockRange *slots; ///< Hash slots
+  size_t capacity;   ///< Number of slots (power of two, 0 before the first insert)
+  size_t count;      ///< Occupied slots
+} PendingRanges;
+
+/**
+ * @brief Contents of a checkpoint file
+ */
+typedef struct
+{
+  long long limit;    ///< Upper limit of the interrupted run
+  long long next;     ///< Every number below this was scanned
+  ResultVector found; ///< Armstrong numbers below next
+} ScanCheckpoint;
+
+/**
+ * @brief Per-thread progress counter, alone on its cache line
+ */
+typedef struct
+{
+  _Alignas(CACHE_LINE) unsigned long long blocks; ///< Blocks finished by the thread
+} ProgressCounter;
+
+/**
+ * @brief Exponent applied to each digit
+ */
+typedef enum
+{
+  RULE_NARCISSISTIC, ///< Number of digits (Armstrong numbers)
+  RULE_FIXED_POWER,  ///< Fixed exponent P (perfect digital invariants)
+  RULE_MUNCHHAUSEN   ///< The digit itself, with 0^0 = 0
+} PowerRule;
+
+/**
+ * @brief Which digit-power numbers to search for
+ */
+typedef struct
+{
+  int base;       ///< Base of the digits (2-36)
+  PowerRule rule; ///< Exponent rule
+  int power;      ///< Exponent for RULE_FIXED_POWER
+} DigitPowerSpec;
+
+/**
+ * @brief Incremental scan of [first, last] for one rule (see digit_power_scan)
+ */
+typedef void (*DigitPowerScanFn)(long long first, long long last, int base, int power, ResultVector *found);
+
+/**
+ * @brief Block kernel: collects every lo in [first, last] with delta[lo] == target
+ * @return Number of hits written to hits
+ */
+typedef int (*BlockKernelFn)(const unsigned long long *delta, int first, int last,
+                             unsigned long long target, int *hits);
 
 /**
  * @brief Program configuration structure
  */
-typedef struct
+typedef struct
+{
+  long long limit; ///< Upper limit for number search
+  bool help;       ///< Flag to show help message
+  int threads;     ///< Number of threads to use
+  SearchMethod method; ///< Search algorithm
+  ScanKernel kernel;   ///< Range scan kernel
+  bool count_only;     ///< Print only how many numbers were found
+  DigitPowerSpec spec; ///< Base and exponent rule
+  int wide_digits;     ///< Search every length up to this in 128 bits (0 = use limit)
+  ScanOptions scan;    ///< Checkpoints and progress of the block scan
+  bool pin;            ///< Pin each thread to one CPU
+  bool scaling;        ///< Print a speedup report over thread counts
+  bool bench;          ///< Run the benchmark sweep instead of one search
+  int bench_min_exp;   ///< Smallest benchmark limit is 10^bench_min_exp
+  int bench_max_exp;   ///< Largest benchmark limit is 10^bench_max_exp
+  ReportFormat format; ///< Benchmark report format
+} ArmstrongConfig;
+
+
+/**
+ * @brief One parallel work item of the multiset search
+ *
+ * The counts of the digits 9 and 8 are fixed; the remaining digits are
+ * enumerated by the thread that takes the item.
+ */
+typedef struct
+{
+  int length; ///< Number of digits
+  int nines;  ///< Count of digit 9
+  int eights; ///< Count of digit 8
+} MultisetTask;
+
+/**
+ * @brief State of one multiset enumeration (one per work item)
+ */
+typedef struct
+{
+  const unsigned long long *pow_row; ///< Powers d^L for the current length L
+  int length;                        ///< Number of digits L
+  int counts[10];                    ///< Digit counts chosen so far
+  unsigned long long low;            ///< Smallest acceptable power sum
+  unsigned long long high;           ///< Largest acceptable power sum
+  ResultVector *found;               ///< Hits (the running thread's vector)
+  unsigned long long evaluated;      ///< Complete multisets checked
+} MultisetSearch;
+
+/**
+ * @brief Growable array of 128-bit results (one per thread while searching)
+ */
+typedef struct
+{
+  WideUint *items; ///< Found numbers
+  size_t count;    ///< Numbers stored
+  size_t capacity; ///< Allocated slots
+} WideVector;
+
+/**
+ * @brief State of one 128-bit multiset enumeration (one per work item)
+ */
+typedef struct
+{
+  const WideUint *pow_row;       ///< Powers d^L for the current length L
+  int length;                    ///< Number of digits L
+  int counts[10];                ///< Digit counts chosen so far
+  WideUint low;                  ///< Smallest acceptable power sum
+  WideUint high;                 ///< Largest acceptable power sum
+  WideVector *found;             ///< Hits (the running thread's vector)
+  unsigned long long evaluated;  ///< Complete multisets checked
+} WideSearch;
+
+/* Lookup tables, built once by init_tables */
+static unsigned long long digit_pow[MAX_DIGITS + 1][10];           // digit_pow[L][d] = d^L
+static unsigned long long pow10_table[MAX_DIGITS + 1];             // 10^0 .. 10^19
+static unsigned long long block_delta[MAX_DIGITS + 1][BLOCK_SIZE]; // Low-digit power sum minus lo
+static WideUint wide_pow[MAX_WIDE_DIGITS + 1][10];                   // d^L for L <= 39 (all fit)
+static WideUint wide_pow10[MAX_WIDE_DIGITS + 1];                     // 10^L, saturated (10^39 does not fit)
+
+/* Function prototypes */
+void parse_args(int argc, char *argv[], ArmstrongConfig *config);
+void print_help(void);
+bool parse_long_long(const char *str, long long *value);
+void handle_input(ArmstrongConfig *config);
+void process_input(ArmstrongConfig *arm, const char *input);
+void init_tables(void);
+bool is_armstrong_number(long long num);
+int count_digits(long long num);
+void print_error(const char *msg);
+void result_push(ResultVector *vector, unsigned long long value);
+ResultVector *result_vectors_create(int count);
+void result_vectors_merge(ResultVector *parts, int count, ResultVector *merged);
+void print_armstrong_numbers(const ResultVector *results, long long limit, bool count_only,
+                             const DigitPowerSpec *spec);
+unsigned long long find_armstrong_numbers(long long limit, int thread_count, BlockKernelFn kernel,
+                                          const ScanOptions *options, ResultVector *results);
+bool checkpoint_load(const char *path, ScanCheckpoint *checkpoint);
+bool checkpoint_save(const char *path, long long limit, long long next, ResultVector *found);
+void pending_insert(PendingRanges *pending, BlockRange range);
+bool pending_take(PendingRanges *pending, long long first, BlockRange *range);
+unsigned long long run_search(const ArmstrongConfig *config, BlockKernelFn kernel, ResultVector *results);
+void print_scaling_report(const ArmstrongConfig *config, BlockKernelFn kernel, const char *kernel_name);
+void init_pinning(void);
+void pin_current_thread(void);
+void unpin_current_thread(void);
+int next_thread_count(int threads, int max_threads);
+bool results_equal(const ResultVector *a, const ResultVector *b);
+int run_benchmark(const ArmstrongConfig *config, BlockKernelFn kernel, const char *kernel_name);
+void report_progress(const ProgressCounter *progress, int thread_count, unsigned long long total_blocks,
+                     double elapsed, bool final);
+int scan_block(long long hi, int last, BlockKernelFn kernel, int *hits);
+BlockKernelFn select_block_kernel(ScanKernel requested, const char **name);
+int block_kernel_scalar(const unsigned long long *delta, int first, int last,
+                        unsigned long long target, int *hits);
+#if ARMSTRONG_SIMD_X86
+int block_kernel_avx2(const unsigned long long *delta, int first, int last,
+                      unsigned long long target, int *hits);
+#endif
+unsigned long long find_armstrong_odometer(long long limit, int thread_count, const DigitPowerSpec *spec,
+                                           ResultVector *results);
+DigitPowerScanFn select_digit_power_scan(const DigitPowerSpec *spec);
+bool is_digit_power_number(unsigned long long num, const DigitPowerSpec *spec);
+unsigned long long digit_power(int digit, int exponent);
+int count_digits_in_base(unsigned long long num, int base);
+unsigned long long find_armstrong_multiset(long long limit, int thread_count, ResultVector *results);
+void search_multiset(MultisetSearch *search, int digit, int remaining, unsigned long long sum);
+bool digits_match_counts(unsigned long long sum, int length, const int counts[10]);
+int compare_ull(const void *a, const void *b);
+void init_wide_tables(void);
+unsigned long long find_armstrong_wide(int max_digits, int thread_count, WideVector *results);
+void search_wide(WideSearch *search, int digit, int remaining, WideUint sum);
+bool wide_prefix_feasible(const WideSearch *search, int digit, int remaining, WideUint min, WideUint max);
+bool wide_digits_match(WideUint value, int length, const int counts[10]);
+int wide_to_digits(WideUint value, int *digits);
+void wide_push(WideVector *vector, WideUint value);
+int compare_wide(const void *a, const void *b);
+void print_wide_numbers(const WideVector *results, int max_digits, bool count_only);
+
+/**
+ * @brief Main program entry point
+ * @param argc Argument count
+ * @param argv Argument vector
+ * @return Exit status (0 for success)
+ */
+int main(int argc, char *argv[])
+{
+  ArmstrongConfig config = {.limit = 0, .help = false, .threads = omp_get_num_procs(), .method = METHOD_MULTISET,
+                            .kernel = KERNEL_AUTO, .count_only = false,
+                            .spec = {.base = 10, .rule = RULE_NARCISSISTIC, .power = 0}, .wide_digits = 0,
+                            .scan = {.checkpoint_path = NULL, .checkpoint_interval = 60, .resume = false,
+                                     .progress = false},
+                            .pin = false, .scaling = false, .bench = false, .bench_min_exp = 6,
+                            .bench_max_exp = 12, .format = FORMAT_TEXT};
+  ResultVector results = {NULL, 0, 0};
+  double start_time, end_time;
+  unsigned long long candidates;
+  const char *kernel_name = "multiset";
+
+  parse_args(argc, argv, &config);
+
+  if (config.help)
+  {
+    print_help();
+    return 0;
+  }
+
+  if (config.pin)
+    init_pinning();
+
+  if (config.wide_digits > 0)
+  {
+    if (config.method == METHOD_SCAN || config.spec.base != 10 || config.spec.rule != RULE_NARCISSISTIC)
+    {
+      print_error("--digits only supports the base-10 multiset search");
+      exit(EXIT_FAILURE);
+    }
+
+    WideVector wide_results = {NULL, 0, 0};
+    init_wide_tables();
+    start_time = omp_get_wtime();
+    candidates = find_armstrong_wide(config.wide_digits, config.threads, &wide_results);
+    end_time = omp_get_wtime();
+    print_wide_numbers(&wide_results, config.wide_digits, config.count_only);
+    free(wide_results.items);
+
+    printf("Time: %.4f seconds\n", end_time - start_time);
+    if (end_time > start_time)
+    {
+      printf("Throughput: %.3e candidates/second (multiset, %s)\n", (double)candidates / (end_time - start_time),
+             ARMSTRONG_INT128 ? "__int128" : "2x64-bit");
+    }
+    return 0;
+  }
+
+  if (config.scan.resume)
+  {
+    ScanCheckpoint checkpoint;
+    if (config.scan.checkpoint_path == NULL || !checkpoint_load(config.scan.checkpoint_path, &checkpoint))
+    {
+      print_error("--resume needs a readable --checkpoint file");
+      exit(EXIT_FAILURE);
+    }
+    free(checkpoint.found.items);
+    if (config.limit != 0 && config.limit != checkpoint.limit)
+    {
+      print_error("The limit differs from the one in the checkpoint");
+      exit(EXIT_FAILURE);
+    }
+    config.limit = checkpoint.limit;
+  }
+
+  if (config.bench)
+    config.limit = MAX_RANGE; // Set per run by run_benchmark
+  handle_input(&config);
+  init_tables();
+
+  // Other bases and exponent rules only have the incremental scan
+  const bool generic = config.spec.base != 10 || config.spec.rule != RULE_NARCISSISTIC;
+  if (generic && (config.kernel == KERNEL_SCALAR || config.kernel == KERNEL_AVX2))
+  {
+    print_error("The block kernels only search base-10 Armstrong numbers");
+    exit(EXIT_FAILURE);
+  }
+  if (generic)
+  {
+    config.method = METHOD_SCAN;
+    config.kernel = KERNEL_ODOMETER;
+  }
+  if ((config.scan.checkpoint_path != NULL || config.scan.progress) &&
+      (config.method != METHOD_SCAN || config.kernel == KERNEL_ODOMETER))
+  {
+    print_error("--checkpoint and --progress need --method scan with a block kernel");
+    exit(EXIT_FAILURE);
+  }
+
+  BlockKernelFn kernel = NULL;
+  if (config.kernel == KERNEL_ODOMETER)
+  {
+    kernel_name = "odometer";
+  }
+  else if ((kernel = select_block_kernel(config.kernel, &kernel_name)) == NULL)
+  {
+    print_error("The requested kernel is not supported by this CPU");
+    exit(EXIT_FAILURE);
+  }
+
+  if (config.method == METHOD_MULTISET)
+    kernel_name = "multiset";
+
+  if (config.bench)
+  {
+    if (generic)
+    {
+      print_error("--bench only supports base-10 Armstrong numbers");
+      exit(EXIT_FAILURE);
+    }
+    return run_benchmark(&config, kernel, kernel_name);
+  }
+
+  start_time = omp_get_wtime();
+  candidates = run_search(&config, kernel, &results);
+  end_time = omp_get_wtime();
+  print_armstrong_numbers(&results, config.limit, config.count_only, &config.spec);
+  free(results.items);
+
+  printf("Time: %.4f seconds\n", end_time - start_time);
+  if (end_time > start_time)
+  {
+    printf("Throughput: %.3e candidates/second (%s)\n", (double)candidates / (end_time - start_time), kernel_name);
+  }
+
+  if (config.scaling)
+    print_scaling_report(&config, kernel, kernel_name);
+
+  return 0;
+}
+
+/**
+ * @brief Runs the search selected by the configuration
+ * @param config Program configuration (limit, threads, method, kernel)
+ * @param kernel Block kernel, or NULL for the odometer and multiset methods
+ * @param results Output: every match up to the limit, sorted
+ * @return Number of candidates tested
+ */
+unsigned long long run_search(const ArmstrongConfig *config, BlockKernelFn kernel, ResultVector *results)
+{
+  if (config->method == METHOD_MULTISET)
+    return find_armstrong_multiset(config->limit, config->threads, results);
+  if (config->kernel == KERNEL_ODOMETER)
+    return find_armstrong_odometer(config->limit, config->threads, &config->spec, results);
+  return find_armstrong_numbers(config->limit, config->threads, kernel, &config->scan, results);
+}
+
+/**
+ * @brief Times the search at 1, 2, 4, ... threads and prints speedup and efficiency
+ * @param config Program configuration (config->threads is the largest count tried)
+ * @param kernel Block kernel, or NULL
+ * @param kernel_name Name shown in the header
+ *
+ * Checkpoints and progress are off for these runs. Every run must find the
+ * same numbers as the single-threaded one.
+ */
+void print_scaling_report(const ArmstrongConfig *config, BlockKernelFn kernel, const char *kernel_name)
+{
+  ArmstrongConfig run = *config;
+  run.scan.checkpoint_path = NULL;
+  run.scan.resume = false;
+  run.scan.progress = false;
+
+  ResultVector reference = {NULL, 0, 0};
+  double serial_time = 0;
+
+  printf("\nScaling report (limit %lld, %s, %d CPUs):\n", config->limit, kernel_name, omp_get_num_procs());
+  printf("Threads    Time (s)   Speedup  Efficiency\n");
+  for (int threads = 1; threads > 0; threads = next_thread_count(threads, config->threads))
+  {
+    ResultVector results = {NULL, 0, 0};
+    run.threads = threads;
+    double start = omp_get_wtime();
+    run_search(&run, kernel, &results);
+    double elapsed = omp_get_wtime() - start;
+
+    if (threads == 1)
+    {
+      reference = results;
+      serial_time = elapsed;
+    }
+    else
+    {
+      if (!results_equal(&results, &reference))
+      {
+        print_error("Results differ from the single-threaded run");
+        exit(EXIT_FAILURE);
+      }
+      free(results.items);
+    }
+
+    const double speedup = elapsed > 0 ? serial_time / elapsed : 0;
+    printf("%7d  %10.4f  %8.2f  %9.1f%%\n", threads, elapsed, speedup, 100.0 * speedup / threads);
+  }
+  free(reference.items);
+}
+
+/**
+ * @brief Next thread count of a 1, 2, 4, ..., max_threads sweep
+ * @param threads Current thread count
+ * @param max_threads Last thread count of the sweep
+ * @return Next count, or 0 after max_threads
+ */
+int next_thread_count(int threads, int max_threads)
+{
+  if (threads >= max_threads)
+    return 0;
+  return threads > max_threads / 2 ? max_threads : threads * 2;
+}
+
+/**
+ * @brief Checks whether two sorted result vectors hold the same numbers
+ */
+bool results_equal(const ResultVector *a, const ResultVector *b)
+{
+  return a->count == b->count && (a->count == 0 || memcmp(a->items, b->items, a->count * sizeof(*a->items)) == 0);
+}
+
+/**
+ * @brief Sweeps limits 10^min..10^max and thread counts 1, 2, 4, ..., threads
+ * @param config Program configuration (method, kernel, threads, sweep, format)
+ * @param kernel Block kernel, or NULL
+ * @param kernel_name Name reported for the kernel
+ * @return EXIT_SUCCESS, or EXIT_FAILURE if any run disagreed
+ *
+ * Every run is checked twice: against the single-threaded run of the same
+ * method and against a single-threaded multiset search, which shares no
+ * code with the scans. Runs shorter than BENCH_MIN_SECONDS are repeated
+ * and the fastest is reported.
+ */
+int run_benchmark(const ArmstrongConfig *config, BlockKernelFn kernel, const char *kernel_name)
+{
+  ArmstrongConfig run = *config;
+  run.scan.checkpoint_path = NULL;
+  run.scan.resume = false;
+  run.scan.progress = false;
+  bool all_match = true;
+  bool first_row = true;
+
+  if (config->format == FORMAT_CSV)
+    printf("method,kernel,limit,threads,seconds,candidates_per_second,speedup,efficiency,found,verified\n");
+  else if (config->format == FORMAT_JSON)
+    printf("[\n");
+  else
+    printf("%-8s %-8s %20s %7s %10s %12s %8s %10s %5s %s\n", "method", "kernel", "limit", "threads", "seconds",
+           "cand/s", "speedup", "efficiency", "found", "verified");
+
+  for (int exponent = config->bench_min_exp; exponent <= config->bench_max_exp; exponent++)
+  {
+    const long long limit = (long long)pow10_table[exponent];
+    ResultVector oracle = {NULL, 0, 0};
+    ResultVector serial = {NULL, 0, 0};
+    double serial_time = 0;
+    find_armstrong_multiset(limit, 1, &oracle);
+    run.limit = limit;
+
+    for (int threads = 1; threads > 0; threads = next_thread_count(threads, config->threads))
+    {
+      ResultVector results = {NULL, 0, 0};
+      unsigned long long candidates = 0;
+      double best = 0;
+      double total = 0;
+      run.threads = threads;
+
+      do
+      {
+        free(results.items);
+        results = (ResultVector){NULL, 0, 0};
+        double start = omp_get_wtime();
+        candidates = run_search(&run, kernel, &results);
+        double elapsed = omp_get_wtime() - start;
+        best = total == 0 || elapsed < best ? elapsed : best;
+        total += elapsed;
+      } while (total < BENCH_MIN_SECONDS);
+
+      if (threads == 1)
+      {
+        serial_time = best;
+        serial = results;
+      }
+      const bool verified = results_equal(&results, &oracle) && results_equal(&results, &serial);
+      all_match = all_match && verified;
+
+      const double rate = best > 0 ? (double)candidates / best : 0;
+      const double speedup = best > 0 ? serial_time / best : 0;
+      const double efficiency = speedup / threads;
+      if (config->format == FORMAT_CSV)
+      {
+        printf("%s,%s,%lld,%d,%.6f,%.4e,%.3f,%.3f,%zu,%s\n", config->method == METHOD_MULTISET ? "multiset" : "scan",
+               kernel_name, limit, threads, best, rate, speedup, efficiency, results.count, verified ? "true" : "false");
+      }
+      else if (config->format == FORMAT_JSON)
+      {
+        printf("%s  {\"method\": \"%s\", \"kernel\": \"%s\", \"limit\": %lld, \"threads\": %d, \"seconds\": %.6f, "
+               "\"candidates_per_second\": %.4e, \"speedup\": %.3f, \"efficiency\": %.3f, \"found\": %zu, "
+               "\"verified\": %s}",
+               first_row ? "" : ",\n", config->method == METHOD_MULTISET ? "multiset" : "scan", kernel_name, limit,
+               threads, best, rate, speedup, efficiency, results.count, verified ? "true" : "false");
+      }
+      else
+      {
+        printf("%-8s %-8s %20lld %7d %10.4f %12.3e %8.2f %9.1f%% %5zu %s\n",
+               config->method == METHOD_MULTISET ? "multiset" : "scan", kernel_name, limit, threads, best, rate,
+               speedup, 100.0 * efficiency, results.count, verified ? "yes" : "NO");
+      }
+      first_row = false;
+      fflush(stdout);
+
+      if (threads != 1)
+        free(results.items);
+    }
+    free(serial.items);
+    free(oracle.items);
+  }
+
+  if (config->format == FORMAT_JSON)
+    printf("\n]\n");
+  if (!all_match)
+    print_error("Some runs returned different results");
+  return all_match ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* --pin state: the CPUs the process may run on, and the mask to restore */
+static struct
+{
+  bool enabled;
+  int cpu_count;
+  int cpus[CPU_SETSIZE];
+  cpu_set_t original;
+} pinning;
+
+/**
+ * @brief Enables --pin: records the allowed CPUs and the initial mask
+ *
+ * The search functions call pin_current_thread at the start of every
+ * parallel region, so each team is pinned whatever its size, and
+ * unpin_current_thread on the main thread afterwards.
+ */
+void init_pinning(void)
+{
+  if (sched_getaffinity(0, sizeof(pinning.original), &pinning.original) != 0 ||
+      CPU_COUNT(&pinning.original) == 0)
+  {
+    print_error("Cannot read the CPU affinity; threads are not pinned");
+    return;
+  }
+
+  pinning.cpu_count = 0;
+  for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+  {
+    if (CPU_ISSET(cpu, &pinning.original))
+      pinning.cpus[pinning.cpu_count++] = cpu;
+  }
+  pinning.enabled = true;
+}
+
+/**
+ * @brief Pins the calling OpenMP thread i to the i-th allowed CPU (with --pin)
+ *
+ * Consecutive threads land on consecutive CPUs of the allowed set, which
+ * keeps neighbours on the same socket/NUMA node, and each thread allocates
+ * its own scan buffers after pinning, so they are first touched on its
+ * node. Threads beyond the number of CPUs wrap around.
+ */
+void pin_current_thread(void)
+{
+  if (!pinning.enabled)
+    return;
+
+  cpu_set_t mine;
+  CPU_ZERO(&mine);
+  CPU_SET(pinning.cpus[omp_get_thread_num() % pinning.cpu_count], &mine);
+  if (sched_setaffinity(0, sizeof(mine), &mine) != 0)
+    print_error("Failed to pin a thread");
+}
+
+/**
+ * @brief Gives the calling thread its initial CPU mask back (with --pin)
+ *
+ * Called by the main thread after each pinned region, which it took part
+ * in as thread 0.
+ */
+void unpin_current_thread(void)
+{
+  if (pinning.enabled)
+    sched_setaffinity(0, sizeof(pinning.original), &pinning.original);
+}
+
+/**
+ * @brief Finds Armstrong numbers by enumerating digit multisets
+ * @param limit Upper limit for the search
+ * @param thread_count Number of threads to use
+ *
+ * An L-digit Armstrong number is determined by which digits it contains,
+ * not their order: the power sum of a multiset is computed once and is a
+ * hit if its own digits are exactly that multiset. There are C(L+9, 9)
+ * multisets of L digits (6.9 million for L = 19) instead of 9 * 10^(L-1)
+ * integers. Items with fixed counts of 9s and 8s are shared out with
+ * dynamic scheduling, since their sizes differ widely.
+ *
+ * @param results Output: every Armstrong number up to limit, sorted
+ * @return Number of multisets checked
+ */
+unsigned long long find_armstrong_multiset(long long limit, int thread_count, ResultVector *results)
+{
+  ResultVector *found = result_vectors_create(thread_count);
+  unsigned long long evaluated = 0;
+
+  int max_length = count_digits(limit);
+
+  // One item per (length, count of 9s, count of 8s)
+  MultisetTask *tasks = malloc(sizeof(MultisetTask) * (MAX_DIGITS + 1) * (MAX_DIGITS + 2) * (MAX_DIGITS + 2) / 2);
+  if (tasks == NULL)
+  {
+    print_error("Out of memory");
+    exit(EXIT_FAILURE);
+  }
+  int task_count = 0;
+  for (int length = 1; length <= max_length; length++)
+  {
+    for (int nines = 0; nines <= length; nines++)
+    {
+      for (int eights = 0; nines + eights <= length; eights++)
+      {
+        tasks[task_count++] = (MultisetTask){length, nines, eights};
+      }
+    }
+  }
+
+#pragma omp parallel num_threads(thread_count) reduction(+ : evaluated)
+  {
+    pin_current_thread();
+
+#pragma omp for schedule(dynamic, 1)
+    for (int t = 0; t < task_count; t++)
+    {
+      const MultisetTask task = tasks[t];
+      MultisetSearch search = {.pow_row = digit_pow[task.length], .length = task.length,
+                               .found = &found[omp_get_thread_num()]};
+
+      // Hits must have exactly `length` digits and not exceed the limit
+      search.low = task.length == 1 ? 1 : pow10_table[task.length - 1];
+      search.high = task.length == max_length ? (unsigned long long)limit : pow10_table[task.length] - 1;
+
+      unsigned long long sum = 0;
+      bool in_range = true;
+      for (int c = 0; c < task.nines + task.eights && in_range; c++)
+      {
+        sum += c < task.nines ? search.pow_row[9] : search.pow_row[8];
+        in_range = sum <= search.high;
+      }
+      if (!in_range)
+        continue;
+
+      search.counts[9] = task.nines;
+      search.counts[8] = task.eights;
+      search_multiset(&search, 7, task.length - task.nines - task.eights, sum);
+      evaluated += search.evaluated;
+    }
+  }
+  unpin_current_thread();
+  free(tasks);
+
+  result_vectors_merge(found, thread_count, results);
+  return evaluated;
+}
+
+/**
+ * @brief Enumerates the counts of digits `digit`..0 and checks each multiset
+ * @param search Search state (counts of the digits above `digit` are set)
+ * @param digit Next digit to choose a count for
+ * @param remaining Digits still to place
+ * @param sum Power sum of the digits chosen so far
+ *
+ * Counts are tried in increasing order, so the loop stops as soon as the
+ * sum passes high; a branch is also skipped when even filling every
+ * remaining place with `digit` cannot reach low. Sums are built by single
+ * additions of at most 9^19 to a value no larger than high, so they cannot
+ * overflow.
+ */
+void search_multiset(MultisetSearch *search, int digit, int remaining, unsigned long long sum)
+{
+  const unsigned long long *pow_row = search->pow_row;
+
+  if (digit == 0)
+  {
+    search->counts[0] = remaining;
+    search->evaluated++;
+    if (sum >= search->low && digits_match_counts(sum, search->length, search->counts))
+    {
+      result_push(search->found, sum);
+    }
+    return;
+  }
+
+  // Even `remaining` copies of `digit` fall short of the range (division avoids overflow)
+  if (sum < search->low &&
+      (remaining == 0 || pow_row[digit] < (search->low - sum + (unsigned long long)remaining - 1) / remaining))
+    return;
+
+  for (int c = 0; c <= remaining; c++)
+  {
+    search->counts[digit] = c;
+    search_multiset(search, digit - 1, remaining - c, sum);
+    if (c < remaining)
+    {
+      sum += pow_row[digit];
+      if (sum > search->high)
+        break;
+    }
+  }
+  search->counts[digit] = 0;
+}
+
+/**
+ * @brief Checks whether a number's digits are exactly a given multiset
+ * @param sum Number to check
+ * @param length Expected number of digits
+ * @param counts Expected count of each digit
+ * @return true if sum has `length` digits with the given counts
+ */
+bool digits_match_counts(unsigned long long sum, int length, const int counts[10])
+{
+  int seen[10] = {0};
+  int digits = 0;
+  while (sum > 0)
+  {
+    if (++seen[sum % 10] > counts[sum % 10])
+      return false;
+    sum /= 10;
+    digits++;
+  }
+  return digits == length;
+}
+
+/**
+ * @brief Compares two unsigned long long values for qsort
+ * @param a First value
+ * @param b Second value
+ * @return Negative, zero or positive as a is less, equal or greater
+ */
+int compare_ull(const void *a, const void *b)
+{
+  unsigned long long x = *(const unsigned long long *)a;
+  unsigned long long y = *(const unsigned long long *)b;
+  return (x > y) - (x < y);
+}
+
+/* ===== 128-bit ARITHMETIC ===== */
+
+#if ARMSTRONG_INT128
+static inline WideUint wide_from(unsigned long long value) { return value; }
+static inline WideUint wide_add(WideUint a, WideUint b) { return a + b; }
+static inline WideUint wide_sub(WideUint a, WideUint b) { return a - b; }
+static inline bool wide_less(WideUint a, WideUint b) { return a < b; }
+static inline WideUint wide_max(void) { return ~(WideUint)0; }
+
+/* a * m; returns true on overflow */
+static inline bool wide_mul_small(WideUint a, unsigned int m, WideUint *product)
+{
+  return __builtin_mul_overflow(a, (WideUint)m, product);
+}
+
+/* a / d, with the remainder in *rem */
+static inline WideUint wide_divmod_small(WideUint a, unsigned int d, unsigned int *rem)
+{
+  *rem = (unsigned int)(a % d);
+  return a / d;
+}
+#else
+static inline WideUint wide_from(unsigned long long value) { return (WideUint){0, value}; }
+
+static inline WideUint wide_add(WideUint a, WideUint b)
+{
+  WideUint r = {a.high + b.high, a.low + b.low};
+  r.high += r.low < a.low;
+  return r;
+}
+
+static inline WideUint wide_sub(WideUint a, WideUint b)
+{
+  WideUint r = {a.high - b.high - (a.low < b.low), a.low - b.low};
+  return r;
+}
+
+static inline bool wide_less(WideUint a, WideUint b)
+{
+  return a.high < b.high || (a.high == b.high && a.low < b.low);
+}
+
+static inline WideUint wide_max(void) { return (WideUint){ULLONG_MAX, ULLONG_MAX}; }
+
+/* a * m in 32-bit limbs; returns true on overflow */
+static inline bool wide_mul_small(WideUint a, unsigned int m, WideUint *product)
+{
+  const unsigned long long limbs[4] = {a.low & 0xffffffffu, a.low >> 32, a.high & 0xffffffffu, a.high >> 32};
+  unsigned long long out[4];
+  unsigned long long carry = 0;
+  for (int i = 0; i < 4; i++)
+  {
+    unsigned long long t = limbs[i] * m + carry;
+    out[i] = t & 0xffffffffu;
+    carry = t >> 32;
+  }
+  product->low = out[0] | out[1] << 32;
+  product->high = out[2] | out[3] << 32;
+  return carry != 0;
+}
+
+/* a / d in 32-bit limbs, with the remainder in *rem */
+static inline WideUint wide_divmod_small(WideUint a, unsigned int d, unsigned int *rem)
+{
+  const unsigned long long limbs[4] = {a.high >> 32, a.high & 0xffffffffu, a.low >> 32, a.low & 0xffffffffu};
+  unsigned long long q[4];
+  unsigned long long r = 0;
+  for (int i = 0; i < 4; i++)
+  {
+    unsigned long long t = r << 32 | limbs[i];
+    q[i] = t / d;
+    r = t % d;
+  }
+  *rem = (unsigned int)r;
+  return (WideUint){q[0] << 32 | q[1], q[2] << 32 | q[3]};
+}
+#endif
+
+/**
+ * @brief Builds the 128-bit power tables
+ *
+ * Every d^L with L <= 39 fits (9^39 < 2^127). Powers of ten that do not
+ * fit are saturated to the largest WideUint, which then serves as the
+ * upper bound for 39-digit sums.
+ */
+void init_wide_tables(void)
+{
+  for (int d = 0; d < 10; d++)
+  {
+    wide_pow[0][d] = wide_from(1);
+    for (int length = 1; length <= MAX_WIDE_DIGITS; length++)
+    {
+      if (wide_mul_small(wide_pow[length - 1][d], (unsigned int)d, &wide_pow[length][d]))
+      {
+        print_error("Power table overflow");
+        exit(EXIT_FAILURE);
+      }
+    }
+  }
+
+  wide_pow10[0] = wide_from(1);
+  for (int length = 1; length <= MAX_WIDE_DIGITS; length++)
+  {
+    if (wide_mul_small(wide_pow10[length - 1], 10, &wide_pow10[length]))
+      wide_pow10[length] = wide_max();
+  }
+}
+
+/**
+ * @brief Finds every Armstrong number with up to max_digits digits in 128 bits
+ * @param max_digits Longest length to search (1-39)
+ * @param thread_count Number of threads to use
+ * @param results Output: every Armstrong number found, sorted
+ * @return Number of multisets checked
+ *
+ * Same work items and dynamic scheduling as find_armstrong_multiset, with
+ * 128-bit sums and prefix pruning (see wide_prefix_feasible).
+ */
+unsigned long long find_armstrong_wide(int max_digits, int thread_count, WideVector *results)
+{
+  WideVector *found = calloc((size_t)thread_count, sizeof(*found));
+  MultisetTask *tasks = malloc(sizeof(MultisetTask) * (MAX_WIDE_DIGITS + 1) * (MAX_WIDE_DIGITS + 2) *
+                               (MAX_WIDE_DIGITS + 2) / 2);
+  if (found == NULL || tasks == NULL)
+  {
+    print_error("Out of memory");
+    exit(EXIT_FAILURE);
+  }
+
+  // Longest lengths first: they dominate the run time
+  int task_count = 0;
+  for (int length = max_digits; length >= 1; length--)
+  {
+    for (int nines = 0; nines <= length; nines++)
+    {
+      for (int eights = 0; nines + eights <= length; eights++)
+      {
+        tasks[task_count++] = (MultisetTask){length, nines, eights};
+      }
+    }
+  }
+
+  unsigned long long evaluated = 0;
+
+#pragma omp parallel num_threads(thread_count) reduction(+ : evaluated)
+  {
+    pin_current_thread();
+
+#pragma omp for schedule(dynamic, 1)
+    for (int t = 0; t < task_count; t++)
+    {
+      const MultisetTask task = tasks[t];
+      WideSearch search = {.pow_row = wide_pow[task.length], .length = task.length,
+                           .found = &found[omp_get_thread_num()]};
+
+      search.low = task.length == 1 ? wide_from(1) : wide_pow10[task.length - 1];
+      search.high = wide_pow10[task.length];
+      if (!wide_less(search.high, wide_max()))
+        search.high = wide_max();
+      else
+        search.high = wide_sub(search.high, wide_from(1));
+
+      WideUint sum = wide_from(0);
+      bool in_range = true;
+      for (int c = 0; c < task.nines + task.eights && in_range; c++)
+      {
+        const WideUint term = c < task.nines ? search.pow_row[9] : search.pow_row[8];
+        in_range = !wide_less(wide_sub(search.high, sum), term);
+        sum = wide_add(sum, term);
+      }
+      if (!in_range)
+        continue;
+
+      search.counts[9] = task.nines;
+      search.counts[8] = task.eights;
+      search_wide(&search, 7, task.length - task.nines - task.eights, sum);
+      evaluated += search.evaluated;
+    }
+  }
+  unpin_current_thread();
+  free(tasks);
+
+  // Lock-free merge after the parallel region
+  size_t total = 0;
+  for (int i = 0; i < thread_count; i++)
+  {
+    total += found[i].count;
+  }
+  results->items = malloc((total > 0 ? total : 1) * sizeof(*results->items));
+  if (results->items == NULL)
+  {
+    print_error("Out of memory");
+    exit(EXIT_FAILURE);
+  }
+  results->count = 0;
+  results->capacity = total;
+  for (int i = 0; i < thread_count; i++)
+  {
+    for (size_t j = 0; j < found[i].count; j++)
+    {
+      results->items[results->count++] = found[i].items[j];
+    }
+    free(found[i].items);
+  }
+  free(found);
+
+  qsort(results->items, results->count, sizeof(*results->items), compare_wide);
+  return evaluated;
+}
+
+/**
+ * @brief 128-bit counterpart of search_multiset
+ * @param search Search state (counts of the digits above `digit` are set)
+ * @param digit Next digit to choose a count for
+ * @param remaining Digits still to place
+ * @param sum Power sum of the digits chosen so far (at most high)
+ *
+ * Every final sum of this branch lies in [sum, sum + remaining * digit^L].
+ * The branch is cut when that interval misses [low, high] or when its
+ * common leading digits cannot be formed from the digits still available.
+ * Additions are checked against high first, so they never overflow.
+ */
+void search_wide(WideSearch *search, int digit, int remaining, WideUint sum)
+{
+  const WideUint pow = search->pow_row[digit];
+
+  if (digit == 0)
+  {
+    search->counts[0] = remaining;
+    search->evaluated++;
+    if (!wide_less(sum, search->low) && wide_digits_match(sum, search->length, search->counts))
+    {
+      wide_push(search->found, sum);
+    }
+    return;
+  }
+
+  // Largest reachable sum, clamped to high
+  WideUint span;
+  WideUint max = search->high;
+  if (!wide_mul_small(pow, (unsigned int)remaining, &span) && wide_less(span, wide_sub(search->high, sum)))
+    max = wide_add(sum, span);
+  if (wide_less(max, search->low))
+    return;
+  if (!wide_prefix_feasible(search, digit, remaining, wide_less(sum, search->low) ? search->low : sum, max))
+    return;
+
+  for (int c = 0; c <= remaining; c++)
+  {
+    search->counts[digit] = c;
+    search_wide(search, digit - 1, remaining - c, sum);
+    if (c < remaining)
+    {
+      if (wide_less(wide_sub(search->high, sum), pow))
+        break;
+      sum = wide_add(sum, pow);
+    }
+  }
+  search->counts[digit] = 0;
+}
+
+/**
+ * @brief Checks the common leading digits of every sum a branch can reach
+ * @param search Search state
+ * @param digit Digit whose count is chosen next
+ * @param remaining Digits still to place (digits 0..digit)
+ * @param min Smallest reachable sum in range
+ * @param max Largest reachable sum in range
+ * @return false if the prefix shared by min and max needs digits the branch cannot supply
+ *
+ * Any hit between min and max starts with their common prefix. A digit
+ * above `digit` may occur there at most as often as its fixed count, and
+ * the prefix may use at most `remaining` of the digits 0..digit.
+ */
+bool wide_prefix_feasible(const WideSearch *search, int digit, int remaining, WideUint min, WideUint max)
+{
+  // No common leading digit when the interval spans 10^(L-1) or more
+  if (!wide_less(wide_sub(max, min), wide_pow10[search->length - 1]))
+    return true;
+
+  int min_digits[MAX_WIDE_DIGITS];
+  int max_digits[MAX_WIDE_DIGITS];
+  wide_to_digits(min, min_digits);
+  wide_to_digits(max, max_digits);
+
+  int seen[10] = {0};
+  int free_used = 0;
+  for (int i = search->length - 1; i >= 0 && min_digits[i] == max_digits[i]; i--)
+  {
+    const int d = min_digits[i];
+    if (d > digit ? ++seen[d] > search->counts[d] : ++free_used > remaining)
+      return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Checks whether a number's digits are exactly a given multiset
+ * @param value Number to check
+ * @param length Expected number of digits
+ * @param counts Expected count of each digit
+ * @return true if the digits of value are exactly counts
+ */
+bool wide_digits_match(WideUint value, int length, const int counts[10])
+{
+  int digits[MAX_WIDE_DIGITS];
+  if (wide_to_digits(value, digits) != length)
+    return false;
+
+  int seen[10] = {0};
+  for (int i = 0; i < length; i++)
+  {
+    if (++seen[digits[i]] > counts[digits[i]])
+      return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Splits a number into decimal digits, least significant first
+ * @param value Number to split
+ * @param digits Output: MAX_WIDE_DIGITS entries, zero-padded
+ * @return Number of significant digits (0 for 0)
+ *
+ * Divides by 10^9 to get 32-bit chunks, then splits each chunk with
+ * cheap 32-bit arithmetic.
+ */
+int wide_to_digits(WideUint value, int *digits)
+{
+  int count = 0;
+  for (int chunk = 0; chunk < (MAX_WIDE_DIGITS + 8) / 9; chunk++)
+  {
+    unsigned int part;
+    value = wide_divmod_small(value, 1000000000u, &part);
+    for (int k = 0; k < 9 && chunk * 9 + k < MAX_WIDE_DIGITS; k++)
+    {
+      digits[chunk * 9 + k] = (int)(part % 10);
+      if (part % 10 != 0)
+        count = chunk * 9 + k + 1;
+      part /= 10;
+    }
+  }
+  return count;
+}
+
+/**
+ * @brief Appends a number, doubling the capacity when full
+ * @param vector Vector owned by the calling thread
+ * @param value Number to append
+ */
+void wide_push(WideVector *vector, WideUint value)
+{
+  if (vector->count == vector->capacity)
+  {
+    size_t capacity = vector->capacity == 0 ? 16 : vector->capacity * 2;
+    WideUint *items = realloc(vector->items, capacity * sizeof(*items));
+    if (items == NULL)
+    {
+      print_error("Out of memory");
+      exit(EXIT_FAILURE);
+    }
+    vector->items = items;
+    vector->capacity = capacity;
+  }
+  vector->items[vector->count++] = value;
+}
+
+/**
+ * @brief Compares two WideUint values for qsort
+ */
+int compare_wide(const void *a, const void *b)
+{
+  const WideUint x = *(const WideUint *)a;
+  const WideUint y = *(const WideUint *)b;
+  return wide_less(y, x) - wide_less(x, y);
+}
+
+/**
+ * @brief Prints the results of the 128-bit search
+ * @param results Armstrong numbers found, sorted
+ * @param max_digits Longest length searched
+ * @param count_only Print only how many numbers were found
+ */
+void print_wide_numbers(const WideVector *results, int max_digits, bool count_only)
+{
+  if (count_only)
+  {
+    printf("Found %zu Armstrong numbers with up to %d digits\n", results->count, max_digits);
+    return;
+  }
+
+  printf("Armstrong numbers with up to %d digits:\n", max_digits);
+  for (size_t i = 0; i < results->count; i++)
+  {
+    int digits[MAX_WIDE_DIGITS];
+    char text[MAX_WIDE_DIGITS + 1];
+    int length = wide_to_digits(results->items[i], digits);
+    for (int k = 0; k < length; k++)
+    {
+      text[k] = (char)('0' + digits[length - 1 - k]);
+    }
+    text[length] = '\0';
+    printf("%s ", text);
+  }
+  printf("\n");
+}
+
+/* ===== RESULT COLLECTION ===== */
+
+/**
+ * @brief Appends a number, doubling the capacity when full
+ * @param vector Vector owned by the calling thread
+ * @param value Number to append
+ */
+void result_push(ResultVector *vector, unsigned long long value)
+{
+  if (vector->count == vector->capacity)
+  {
+    size_t capacity = vector->capacity == 0 ? 16 : vector->capacity * 2;
+    unsigned long long *items = realloc(vector->items, capacity * sizeof(*items));
+    if (items == NULL)
+    {
+      print_error("Out of memory");
+      exit(EXIT_FAILURE);
+    }
+    vector->items = items;
+    vector->capacity = capacity;
+  }
+  vector->items[vector->count++] = value;
+}
+
+/**
+ * @brief Allocates one empty result vector per thread
+ * @param count Number of vectors
+ * @return Vectors (release with result_vectors_merge)
+ */
+ResultVector *result_vectors_create(int count)
+{
+  ResultVector *vectors = calloc((size_t)count, sizeof(*vectors));
+  if (vectors == NULL)
+  {
+    print_error("Out of memory");
+    exit(EXIT_FAILURE);
+  }
+  return vectors;
+}
+
+/**
+ * @brief Concatenates the per-thread vectors and sorts the result
+ * @param parts Per-thread vectors (freed)
+ * @param count Number of vectors
+ * @param merged Output vector (replaced)
+ *
+ * Runs after the parallel region, so each thread filled only its own
+ * vector and no locking is needed.
+ */
+void result_vectors_merge(ResultVector *parts, int count, ResultVector *merged)
+{
+  size_t total = 0;
+  for (int i = 0; i < count; i++)
+  {
+    total += parts[i].count;
+  }
+
+  merged->items = malloc((total > 0 ? total : 1) * sizeof(*merged->items));
+  if (merged->items == NULL)
+  {
+    print_error("Out of memory");
+    exit(EXIT_FAILURE);
+  }
+  merged->count = 0;
+  merged->capacity = total;
+  for (int i = 0; i < count; i++)
+  {
+    if (parts[i].count > 0)
+    {
+      memcpy(merged->items + merged->count, parts[i].items, parts[i].count * sizeof(*merged->items));
+      merged->count += parts[i].count;
+    }
+    free(parts[i].items);
+  }
+  free(parts);
+
+  qsort(merged->items, merged->count, sizeof(*merged->items), compare_ull);
+}
+
+/**
+ * @brief Finds ArmstrongConfig numbers in parallel using OpenMP
+ * @param limit Upper limit for the search
+ * @param thread_count Number of threads to use
+ * @param kernel Block kernel used for the scan
+ * @param options Checkpoint and progress options
+ * @param results Output: every Armstrong number up to limit, sorted
+ * @return Number of candidates tested
+ *
+ * Threads take chunks of blocks of BLOCK_SIZE consecutive numbers from a
+ * shared atomic counter, so chunks start in increasing order. Each thread
+ * sizes its next chunk from the measured cost per block of its last one,
+ * aiming at TARGET_CHUNK_SECONDS: blocks of long numbers, and blocks that
+ * cannot be skipped, cost more. Near the end chunks shrink so that the
+ * threads finish together. Hits go to thread-local result vectors.
+ *
+ * With checkpoints, a finished chunk is recorded under a named critical
+ * section (once per chunk, not per number), which keeps the watermark:
+ * the first block not covered by the run of finished chunks from the start. Every
+ * checkpoint_interval seconds the watermark and the hits below it are
+ * saved, so a resumed run repeats at most the chunks in flight. Progress
+ * comes from per-thread counters on separate cache lines, written only by
+ * their owner and summed by thread 0.
+ */
+unsigned long long find_armstrong_numbers(long long limit, int thread_count, BlockKernelFn kernel,
+                                          const ScanOptions *options, ResultVector *results)
+{
+  ResultVector *found = result_vectors_create(thread_count);
+  const long long last_block = limit / BLOCK_SIZE;
+  long long first_block = 0;
+  const bool checkpointing = options->checkpoint_path != NULL;
+
+  ResultVector done_hits = {NULL, 0, 0};     // Hits of finished chunks (checkpointing only)
+  PendingRanges pending = {NULL, 0, 0};      // Finished chunks above the watermark
+  double last_save = omp_get_wtime();
+
+  if (options->resume)
+  {
+    ScanCheckpoint checkpoint;
+    if (!checkpoint_load(options->checkpoint_path, &checkpoint))
+    {
+      print_error("Cannot read the checkpoint file");
+      exit(EXIT_FAILURE);
+    }
+    first_block = checkpoint.next / BLOCK_SIZE;
+    for (size_t i = 0; i < checkpoint.found.count; i++)
+    {
+      result_push(&found[0], checkpoint.found.items[i]);
+      result_push(&done_hits, checkpoint.found.items[i]);
+    }
+    free(checkpoint.found.items);
+  }
+
+  const unsigned long long total_blocks = last_block >= first_block ? (unsigned long long)(last_block - first_block + 1) : 0;
+  long long next_block = first_block; // Dispatcher
+  long long watermark = first_block;  // Blocks below this are finished
+  ProgressCounter *progress = aligned_alloc(CACHE_LINE, sizeof(ProgressCounter) * (size_t)thread_count);
+  if (progress == NULL)
+  {
+    print_error("Out of memory");
+    exit(EXIT_FAILURE);
+  }
+  memset(progress, 0, sizeof(ProgressCounter) * (size_t)thread_count);
+  const double start_time = omp_get_wtime();
+
+#pragma omp parallel num_threads(thread_count)
+  {
+    pin_current_thread();
+    const int id = omp_get_thread_num();
+    ResultVector *local = &found[id];
+    ResultVector chunk_hits = {NULL, 0, 0};
+    double last_report = start_time;
+    long long chunk_blocks = MIN_CHUNK_BLOCKS;
+    int hits[BLOCK_SIZE];
+
+    for (;;)
+    {
+      const long long lo_block = __atomic_fetch_add(&next_block, chunk_blocks, __ATOMIC_RELAXED);
+      if (lo_block > last_block)
+        break;
+      const long long hi_block = last_block - lo_block < chunk_blocks ? last_block : lo_block + chunk_blocks - 1;
+      const double chunk_start = omp_get_wtime();
+
+      for (long long hi = lo_block; hi <= hi_block; hi++)
+      {
+        int last = hi == last_block ? (int)(limit % BLOCK_SIZE) : BLOCK_SIZE - 1;
+        int count = scan_block(hi, last, kernel, hits);
+        for (int k = 0; k < count; k++)
+        {
+          result_push(local, (unsigned long long)(hi * BLOCK_SIZE + hits[k]));
+          if (checkpointing)
+            result_push(&chunk_hits, (unsigned long long)(hi * BLOCK_SIZE + hits[k]));
+        }
+      }
+      __atomic_store_n(&progress[id].blocks, progress[id].blocks + (unsigned long long)(hi_block - lo_block + 1),
+                       __ATOMIC_RELAXED);
+
+      // Size the next chunk from this one's cost per block
+      const double chunk_time = omp_get_wtime() - chunk_start;
+      double wanted = chunk_time > 0 ? TARGET_CHUNK_SECONDS * (double)(hi_block - lo_block + 1) / chunk_time
+                                     : (double)MAX_CHUNK_BLOCKS;
+      const long long left = last_block - __atomic_load_n(&next_block, __ATOMIC_RELAXED);
+      if (wanted > (double)left / (2.0 * thread_count))
+        wanted = (double)left / (2.0 * thread_count);
+      chunk_blocks = wanted < MIN_CHUNK_BLOCKS ? MIN_CHUNK_BLOCKS
+                     : wanted > MAX_CHUNK_BLOCKS ? MAX_CHUNK_BLOCKS
+                                                 : (long long)wanted;
+
+      if (checkpointing)
+      {
+#pragma omp critical(checkpoint)
+        {
+          for (size_t k = 0; k < chunk_hits.count; k++)
+          {
+            result_push(&done_hits, chunk_hits.items[k]);
+          }
+          // Advance the watermark over every chunk now known to be finished
+          if (lo_block == watermark)
+            watermark = hi_block + 1;
+          else
+            pending_insert(&pending, (BlockRange){lo_block, hi_block});
+          BlockRange next_done;
+          while (pending_take(&pending, watermark, &next_done))
+            watermark = next_done.last + 1;
+
+          const double now = omp_get_wtime();
+          if (now - last_save >= options->checkpoint_interval)
+          {
+            if (!checkpoint_save(options->checkpoint_path, limit, watermark * BLOCK_SIZE, &done_hits))
+              print_error("Failed to write the checkpoint file");
+            last_save = now;
+          }
+        }
+        chunk_hits.count = 0;
+      }
+
+      if (options->progress && id == 0)
+      {
+        const double now = omp_get_wtime();
+        if (now - last_report >= 1.0)
+        {
+          report_progress(progress, thread_count, total_blocks, now - start_time, false);
+          last_report = now;
+        }
+      }
+    }
+    free(chunk_hits.items);
+  }
+  unpin_current_thread();
+
+  if (options->progress)
+    report_progress(progress, thread_count, total_blocks, omp_get_wtime() - start_time, true);
+  if (checkpointing && !checkpoint_save(options->checkpoint_path, limit, (last_block + 1) * BLOCK_SIZE, &done_hits))
+    print_error("Failed to write the checkpoint file");
+
+  free(progress);
+  free(pending.slots);
+  free(done_hits.items);
+  result_vectors_merge(found, thread_count, results);
+  return first_block > last_block ? 0 : (unsigned long long)(limit - first_block * BLOCK_SIZE);
+}
+
+/**
+ * @brief Prints a progress line with throughput and ETA to stderr
+ * @param progress Per-thread counters
+ * @param thread_count Number of counters
+ * @param total_blocks Blocks in the whole scan
+ * @param elapsed Seconds since the scan started
+ * @param final Print the finished state and end the line
+ */
+void report_progress(const ProgressCounter *progress, int thread_count, unsigned long long total_blocks,
+                     double elapsed, bool final)
+{
+  unsigned long long done = 0;
+  for (int i = 0; i < thread_count; i++)
+  {
+    done += __atomic_load_n(&progress[i].blocks, __ATOMIC_RELAXED);
+  }
+
+  const double fraction = total_blocks > 0 ? (double)done / (double)total_blocks : 1.0;
+  const double rate = elapsed > 0 ? (double)done * BLOCK_SIZE / elapsed : 0.0;
+  const double eta = done > 0 ? elapsed * (double)(total_blocks - done) / (double)done : 0.0;
+  const long long eta_seconds = (long long)eta;
+
+  fprintf(stderr, "\rProgress: %5.1f%%  %.3e numbers/s  ETA %lld:%02lld:%02lld%s", 100.0 * fraction, rate,
+          eta_seconds / 3600, eta_seconds / 60 % 60, eta_seconds % 60, final ? "\n" : "");
+  fflush(stderr);
+}
+
+/**
+ * @brief Returns the home slot of a chunk in the pending table
+ */
+static size_t pending_slot(const PendingRanges *pending, long long first)
+{
+  return (size_t)(((unsigned long long)first * 0x9E3779B97F4A7C15ULL) >> 32) & (pending->capacity - 1);
+}
+
+/**
+ * @brief Records a finished chunk that starts above the watermark
+ * @param pending Pending table
+ * @param range Finished chunk
+ *
+ * The table doubles when it would become more than half full.
+ */
+void pending_insert(PendingRanges *pending, BlockRange range)
+{
+  if (2 * (pending->count + 1) > pending->capacity)
+  {
+    PendingRanges grown = {NULL, pending->capacity == 0 ? 16 : pending->capacity * 2, 0};
+    grown.slots = malloc(grown.capacity * sizeof(*grown.slots));
+    if (grown.slots == NULL)
+    {
+      print_error("Out of memory");
+      exit(EXIT_FAILURE);
+    }
+    for (size_t i = 0; i < grown.capacity; i++)
+      grown.slots[i].first = -1;
+    for (size_t i = 0; i < pending->capacity; i++)
+    {
+      if (pending->slots[i].first != -1)
+        pending_insert(&grown, pending->slots[i]);
+    }
+    free(pending->slots);
+    *pending = grown;
+  }
+
+  size_t i = pending_slot(pending, range.first);
+  while (pending->slots[i].first != -1)
+    i = (i + 1) & (pending->capacity - 1);
+  pending->slots[i] = range;
+  pending->count++;
+}
+
+/**
+ * @brief Removes the finished chunk starting at a given block, if any
+ * @param pending Pending table
+ * @param first First block of the wanted chunk
+ * @param range Output: the chunk
+ * @return true if the chunk was pending
+ *
+ * Deletion shifts later entries of the probe run back into the hole, so
+ * lookups never need tombstones.
+ */
+bool pending_take(PendingRanges *pending, long long first, BlockRange *range)
+{
+  if (pending->count == 0)
+    return false;
+
+  const size_t mask = pending->capacity - 1;
+  size_t i = pending_slot(pending, first);
+  while (pending->slots[i].first != first)
+  {
+    if (pending->slots[i].first == -1)
+      return false;
+    i = (i + 1) & mask;
+  }
+  *range = pending->slots[i];
+  pending->count--;
+
+  size_t hole = i;
+  for (size_t j = (i + 1) & mask; pending->slots[j].first != -1; j = (j + 1) & mask)
+  {
+    // An entry may move back only if its home slot is not between the hole and itself
+    const size_t home = pending_slot(pending, pending->slots[j].first);
+    if (((j - home) & mask) >= ((j - hole) & mask))
+    {
+      pending->slots[hole] = pending->slots[j];
+      hole = j;
+    }
+  }
+  pending->slots[hole].first = -1;
+  return true;
+}
+
+/**
+ * @brief Writes a checkpoint atomically (temporary file, then rename)
+ * @param path State file
+ * @param limit Upper limit of the run
+ * @param next Every number below this was scanned
+ * @param found Hits of finished chunks (sorted in place; those >= next are skipped)
+ * @return true on success
+ */
+bool checkpoint_save(const char *path, long long limit, long long next, ResultVector *found)
 {
-  long long limit; ///< Upper limit for number search
-  bool help;       ///< Flag to show help message
-  int threads;     ///< Number of threads to use
-} ArmstrongConfig;
+  char temp_path[MAX_INPUT_LEN + 8];
+  if (snprintf(temp_path, sizeof(temp_path), "%s.tmp", path) >= (int)sizeof(temp_path))
+    return false;
 
-/* Function prototypes */
-void parse_args(int argc, char *argv[], ArmstrongConfig *config);
-void print_help(void);
-bool parse_long_long(const char *str, long long *value);
-void handle_input(ArmstrongConfig *config);
-void process_input(ArmstrongConfig *arm, const char *input);
-bool is_armstrong_number(long long num);
-int count_digits(long long num);
-long long ipow(long long base, int exp);
-void print_error(const char *msg);
-void find_armstrong_numbers(long long limit, int thread_count);
-void print_armstrong_numbers(long long limit);
+  qsort(found->items, found->count, sizeof(*found->items), compare_ull);
+  size_t below = 0;
+  while (below < found->count && found->items[below] < (unsigned long long)next)
+    below++;
+
+  FILE *file = fopen(temp_path, "w");
+  if (file == NULL)
+    return false;
+  fprintf(file, "%s\nlimit %lld\nnext %lld\nfound %zu\n", CHECKPOINT_MAGIC, limit, next, below);
+  for (size_t i = 0; i < below; i++)
+  {
+    fprintf(file, "%llu\n", found->items[i]);
+  }
+  bool ok = !ferror(file);
+  ok = fclose(file) == 0 && ok;
+  return ok && rename(temp_path, path) == 0;
+}
 
 /**
- * @brief Main program entry point
- * @param argc Argument count
- * @param argv Argument vector
- * @return Exit status (0 for success)
+ * @brief Reads a checkpoint written by checkpoint_save
+ * @param path State file
+ * @param checkpoint Output (free checkpoint->found.items)
+ * @return false if the file is missing or malformed
  */
-int main(int argc, char *argv[])
+bool checkpoint_load(const char *path, ScanCheckpoint *checkpoint)
 {
-  ArmstrongConfig config = {.limit = 0, .help = false, .threads = 4};
-  double start_time, end_time;
+  char magic[64];
+  size_t count;
+  FILE *file = fopen(path, "r");
+  if (file == NULL)
+    return false;
 
-  parse_args(argc, argv, &config);
+  checkpoint->found = (ResultVector){NULL, 0, 0};
+  bool ok = fgets(magic, sizeof(magic), file) != NULL && strncmp(magic, CHECKPOINT_MAGIC, strlen(CHECKPOINT_MAGIC)) == 0 &&
+            fscanf(file, " limit %lld next %lld found %zu", &checkpoint->limit, &checkpoint->next, &count) == 3 &&
+            checkpoint->limit >= 1 && checkpoint->next >= 0;
+  for (size_t i = 0; ok && i < count; i++)
+  {
+    unsigned long long value;
+    ok = fscanf(file, "%llu", &value) == 1;
+    if (ok)
+      result_push(&checkpoint->found, value);
+  }
+  fclose(file);
+  if (!ok)
+    free(checkpoint->found.items);
+  return ok;
+}
 
-  if (config.help)
+/**
+ * @brief Finds the Armstrong numbers in one block of BLOCK_SIZE numbers
+ * @param hi Block index: the block holds hi * BLOCK_SIZE + [0, last]
+ * @param last Last low part to test (BLOCK_SIZE - 1 except in the final block)
+ * @param kernel Block kernel
+ * @param hits Output: low parts of the hits (room for BLOCK_SIZE entries)
+ * @return Number of hits
+ *
+ * Every number in a block with hi > 0 has the same length L and the same
+ * high digits, so n = hi * 10^4 + lo is an Armstrong number exactly when
+ * S(hi) + T(lo) == hi * 10^4 + lo, where S and T are the power sums of the
+ * high and low digits. With block_delta[L][lo] = T(lo) - lo this becomes
+ * block_delta[L][lo] == hi * 10^4 - S(hi): one compare per candidate. The
+ * equation is evaluated modulo 2^64, which is exact because blocks whose
+ * S(hi) already exceeds the block are skipped (S(hi) is summed with an
+ * overflow check, as 15 * 9^19 does not fit in 64 bits), so
+ * S(hi) + T(lo) <= LLONG_MAX + 4 * 9^19 < 2^64.
+ */
+int scan_block(long long hi, int last, BlockKernelFn kernel, int *hits)
+{
+  if (hi == 0)
   {
-    print_help();
-    return 0;
+    int count = 0;
+    for (int lo = 1; lo <= last; lo++)
+    {
+      if (is_armstrong_number(lo))
+        hits[count++] = lo;
+    }
+    return count;
   }
 
-  handle_input(&config);
+  const int length = count_digits(hi) + BLOCK_DIGITS;
+  const unsigned long long *row = digit_pow[length];
+  const unsigned long long base = (unsigned long long)hi * BLOCK_SIZE;
+  unsigned long long high_sum = 0;
+  for (long long h = hi; h > 0; h /= 10)
+  {
+    if (__builtin_add_overflow(high_sum, row[h % 10], &high_sum))
+      return 0; // S(hi) >= 2^64 exceeds every number in the block
+  }
+  if (high_sum > base + (unsigned long long)last)
+    return 0;
 
-  start_time = omp_get_wtime();
+  return kernel(block_delta[length], 0, last, base - high_sum, hits);
+}
 
-  if (config.threads > 1)
+/**
+ * @brief Chooses the block kernel
+ * @param requested Kernel asked for on the command line
+ * @param name Receives the kernel name
+ * @return Kernel, or NULL if the CPU does not support the requested one
+ */
+BlockKernelFn select_block_kernel(ScanKernel requested, const char **name)
+{
+#if ARMSTRONG_SIMD_X86
+  if (requested != KERNEL_SCALAR && __builtin_cpu_supports("avx2"))
   {
-    find_armstrong_numbers(config.limit, config.threads);
+    *name = "avx2";
+    return block_kernel_avx2;
   }
-  else
+#endif
+  if (requested == KERNEL_AVX2)
+    return NULL;
+  *name = "scalar";
+  return block_kernel_scalar;
+}
+
+/**
+ * @brief Portable block kernel
+ * @param delta block_delta row for the block length
+ * @param first First low part to test
+ * @param last Last low part to test
+ * @param target Value delta must equal for a hit
+ * @param hits Output: low parts of the hits
+ * @return Number of hits
+ *
+ * Tests four candidates per iteration with one combined branch; hits are
+ * rare, so the inner re-check almost never runs.
+ */
+int block_kernel_scalar(const unsigned long long *delta, int first, int last,
+                        unsigned long long target, int *hits)
+{
+  int count = 0;
+  int lo = first;
+
+  for (; lo + 3 <= last; lo += 4)
+  {
+    if ((delta[lo] == target) | (delta[lo + 1] == target) | (delta[lo + 2] == target) | (delta[lo + 3] == target))
+    {
+      for (int k = lo; k < lo + 4; k++)
+      {
+        if (delta[k] == target)
+          hits[count++] = k;
+      }
+    }
+  }
+  for (; lo <= last; lo++)
   {
-    print_armstrong_numbers(config.limit);
+    if (delta[lo] == target)
+      hits[count++] = lo;
   }
+  return count;
+}
 
-  end_time = omp_get_wtime();
-  printf("Time: %.4f seconds\n", end_time - start_time);
+#if ARMSTRONG_SIMD_X86
+/**
+ * @brief AVX2 block kernel
+ * @param delta block_delta row for the block length
+ * @param first First low part to test
+ * @param last Last low part to test
+ * @param target Value delta must equal for a hit
+ * @param hits Output: low parts of the hits
+ * @return Number of hits
+ *
+ * Compares eight 64-bit deltas per iteration with two vpcmpeqq.
+ */
+__attribute__((target("avx2"))) int block_kernel_avx2(const unsigned long long *delta, int first, int last,
+                                                      unsigned long long target, int *hits)
+{
+  const __m256i wanted = _mm256_set1_epi64x((long long)target);
+  int count = 0;
+  int lo = first;
 
-  return 0;
+  for (; lo + 7 <= last; lo += 8)
+  {
+    __m256i a = _mm256_loadu_si256((const __m256i *)(delta + lo));
+    __m256i b = _mm256_loadu_si256((const __m256i *)(delta + lo + 4));
+    __m256i eq = _mm256_or_si256(_mm256_cmpeq_epi64(a, wanted), _mm256_cmpeq_epi64(b, wanted));
+    if (!_mm256_testz_si256(eq, eq))
+    {
+      for (int k = lo; k < lo + 8; k++)
+      {
+        if (delta[k] == target)
+          hits[count++] = k;
+      }
+    }
+  }
+  for (; lo <= last; lo++)
+  {
+    if (delta[lo] == target)
+      hits[count++] = lo;
+  }
+  return count;
 }
+#endif
 
 /**
- * @brief Finds ArmstrongConfig numbers in parallel using OpenMP
+ * @brief Finds digit-power numbers with the incremental (odometer) scan
  * @param limit Upper limit for the search
  * @param thread_count Number of threads to use
+ * @param spec Base and exponent rule
+ * @param results Output: every match up to limit, sorted
+ * @return Number of candidates tested
  *
- * Uses thread-local buffers and dynamic scheduling for efficient parallelization.
- * Suitable for ranges up to 10 billion on modest hardware.
+ * The range 1..limit is cut into one contiguous subrange per thread. The
+ * cost per candidate is the same everywhere, so a static split balances.
  */
-void find_armstrong_numbers(long long limit, int thread_count)
+unsigned long long find_armstrong_odometer(long long limit, int thread_count, const DigitPowerSpec *spec,
+                                           ResultVector *results)
 {
-  long long results[100] = {0}; // Fixed-size result buffer
-  int result_count = 0;         // Number of found ArmstrongConfig numbers
+  ResultVector *found = result_vectors_create(thread_count);
+  const DigitPowerScanFn scan = select_digit_power_scan(spec);
 
 #pragma omp parallel num_threads(thread_count)
   {
-    // Thread-local storage to minimize synchronization
-    long long local_results[20] = {0};
-    int local_count = 0;
+    pin_current_thread();
+    const long long threads = omp_get_num_threads();
+    const long long id = omp_get_thread_num();
+    const long long span = limit / threads;
+    const long long first = 1 + id * span;
+    const long long last = id == threads - 1 ? limit : first + span - 1;
+
+    if (first <= last)
+      scan(first, last, spec->base, spec->power, &found[id]);
+  }
+  unpin_current_thread();
+
+  result_vectors_merge(found, thread_count, results);
+  return (unsigned long long)limit;
+}
+
+/**
+ * @brief Scans [first, last] keeping the digits and their power sum up to date
+ * @param first First number to test (at least 1)
+ * @param last Last number to test
+ * @param found Output: hits are appended in increasing order
+ * @param base Base of the digits
+ * @param rule Exponent rule
+ * @param power Exponent for RULE_FIXED_POWER
+ *
+ * The number is kept as a prefix (all digits but the last) plus a last
+ * digit. Stepping the last digit costs one load, add and compare; the
+ * prefix and its power sum change only once per `base` numbers, when a
+ * carry ripples through the stored digit vector. The digit count, and with
+ * it the power row of RULE_NARCISSISTIC, is reset at each power of the base.
+ *
+ * Always inlined into the DEFINE_DIGIT_POWER_SCAN instances, where base
+ * and rule are constants, so the base-10 Armstrong scan compiles to the
+ * same loop as a hand-written one. Sums are kept modulo 2^64 and power
+ * entries that overflow are saturated: such a digit makes the true sum
+ * exceed any candidate, and every modular match is confirmed with the
+ * overflow-checked is_digit_power_number.
+ */
+static inline __attribute__((always_inline)) void digit_power_scan(long long first, long long last,
+                                                                   ResultVector *found, const int base,
+                                                                   const PowerRule rule, const int power)
+{
+  const DigitPowerSpec spec = {base, rule, power};
+  unsigned long long n = (unsigned long long)first;
+
+  while (n <= (unsigned long long)last)
+  {
+    const int length = count_digits_in_base(n, base);
 
-// Process numbers in dynamically assigned chunks
-#pragma omp for schedule(dynamic, 10000)
-    for (long long i = 1; i <= limit; i++)
+    // Numbers of this digit count end at base^length - 1 (or at last)
+    unsigned long long stop = (unsigned long long)last;
+    unsigned long long next_power = 1;
+    bool overflow = false;
+    for (int k = 0; k < length && !overflow; k++)
+      overflow = __builtin_mul_overflow(next_power, (unsigned long long)base, &next_power);
+    if (!overflow && next_power - 1 < stop)
+      stop = next_power - 1;
+
+    unsigned long long row[MAX_BASE];
+    for (int d = 0; d < base; d++)
     {
-      if (is_armstrong_number(i))
-      {
-        local_results[local_count++] = i;
+      row[d] = digit_power(d, rule == RULE_NARCISSISTIC ? length : rule == RULE_FIXED_POWER ? power : d);
+    }
+
+    // Prefix digits, least significant first (digits[0] is unused)
+    int digits[MAX_BASE_DIGITS + 1] = {0};
+    unsigned long long prefix_sum = 0;
+    unsigned long long prefix = n / (unsigned long long)base;
+    for (int k = 1; prefix > 0; k++, prefix /= (unsigned long long)base)
+    {
+      digits[k] = (int)(prefix % (unsigned long long)base);
+      prefix_sum += row[digits[k]];
+    }
 
-        // Periodically merge to global results
-        if (local_count >= 10)
+    const unsigned long long top = (unsigned long long)base - 1;
+    unsigned long long low = n - n % (unsigned long long)base;
+    unsigned long long d = n % (unsigned long long)base;
+    for (;;)
+    {
+      const unsigned long long end = stop - low < top ? stop - low : top;
+      for (; d <= end; d++)
+      {
+        if (prefix_sum + row[d] == low + d && is_digit_power_number(low + d, &spec))
         {
-#pragma omp critical
-          {
-            for (int j = 0; j < local_count && result_count < 100; j++)
-            {
-              results[result_count++] = local_results[j];
-            }
-          }
-          local_count = 0;
+          result_push(found, low + d);
         }
       }
-    }
+      if (stop - low <= top)
+        break;
 
-// Merge any remaining numbers
-#pragma omp critical
-    {
-      for (int j = 0; j < local_count && result_count < 100; j++)
+      // Lazy carry: only the prefix changes, once per `base` numbers
+      low += (unsigned long long)base;
+      d = 0;
+      int k = 1;
+      while (digits[k] == base - 1)
       {
-        results[result_count++] = local_results[j];
+        prefix_sum -= row[base - 1];
+        digits[k++] = 0;
       }
+      prefix_sum += row[digits[k] + 1] - row[digits[k]];
+      digits[k]++;
     }
+
+    n = stop + 1;
   }
+}
 
-  // Output results (already nearly ordered)
-  for (int i = 0; i < result_count; i++)
-  {
-    printf("%lld ", results[i]);
+/* BASE 0 takes the base from the argument; any other value is a constant */
+#define DEFINE_DIGIT_POWER_SCAN(NAME, BASE, RULE)                                                  \
+  static void scan_##NAME(long long first, long long last, int base, int power, ResultVector *found) \
+  {                                                                                                \
+    (void)base;                                                                                    \
+    digit_power_scan(first, last, found, (BASE) != 0 ? (BASE) : base, RULE, power);               \
   }
-  printf("\n");
+
+DEFINE_DIGIT_POWER_SCAN(narcissistic_10, 10, RULE_NARCISSISTIC)
+DEFINE_DIGIT_POWER_SCAN(fixed_power_10, 10, RULE_FIXED_POWER)
+DEFINE_DIGIT_POWER_SCAN(munchhausen_10, 10, RULE_MUNCHHAUSEN)
+DEFINE_DIGIT_POWER_SCAN(narcissistic_any, 0, RULE_NARCISSISTIC)
+DEFINE_DIGIT_POWER_SCAN(fixed_power_any, 0, RULE_FIXED_POWER)
+DEFINE_DIGIT_POWER_SCAN(munchhausen_any, 0, RULE_MUNCHHAUSEN)
+
+/**
+ * @brief Chooses the scan instance for a base and rule
+ * @param spec Base and exponent rule
+ * @return Base-10 specialisation when base is 10, generic instance otherwise
+ */
+DigitPowerScanFn select_digit_power_scan(const DigitPowerSpec *spec)
+{
+  static const DigitPowerScanFn base10[] = {scan_narcissistic_10, scan_fixed_power_10, scan_munchhausen_10};
+  static const DigitPowerScanFn any_base[] = {scan_narcissistic_any, scan_fixed_power_any, scan_munchhausen_any};
+  return spec->base == 10 ? base10[spec->rule] : any_base[spec->rule];
 }
 
 /**
- * @brief Checks if a number is an ArmstrongConfig number
+ * @brief Checks a number against a base and exponent rule
  * @param num Number to check
- * @return true if ArmstrongConfig number, false otherwise
+ * @param spec Base and exponent rule
+ * @return true if the digit-power sum equals num
  *
- * Uses optimized algorithm with custom power function (ipow)
+ * Exact: the sum is abandoned as soon as it would overflow.
  */
-bool is_armstrong_number(long long num)
+bool is_digit_power_number(unsigned long long num, const DigitPowerSpec *spec)
 {
-  if (num < 10)
-    return true; // Single-digit numbers are always Armstrong
+  const int length = count_digits_in_base(num, spec->base);
+  unsigned long long sum = 0;
+
+  for (unsigned long long n = num; n > 0; n /= (unsigned long long)spec->base)
+  {
+    const int digit = (int)(n % (unsigned long long)spec->base);
+    const int exponent = spec->rule == RULE_NARCISSISTIC ? length : spec->rule == RULE_FIXED_POWER ? spec->power : digit;
+    const unsigned long long term = digit_power(digit, exponent);
+    if (term == ULLONG_MAX || __builtin_add_overflow(sum, term, &sum))
+      return false;
+  }
+  return sum == num;
+}
 
-  const long long original = num;
-  long long sum = 0;
-  const int digits = count_digits(num);
+/**
+ * @brief Raises a digit to a power
+ * @param digit Digit (0-35)
+ * @param exponent Exponent (0 for Munchhausen zeros)
+ * @return digit^exponent, 0 for digit 0, or ULLONG_MAX if it overflows
+ */
+unsigned long long digit_power(int digit, int exponent)
+{
+  if (digit == 0)
+    return 0;
 
-  while (num > 0)
+  unsigned long long result = 1;
+  for (int e = 0; e < exponent; e++)
   {
-    const int digit = num % 10;
-    sum += ipow(digit, digits);
-    if (sum > original)
-      break; // Early exit if sum exceeds original
-    num /= 10;
+    if (__builtin_mul_overflow(result, (unsigned long long)digit, &result))
+      return ULLONG_MAX;
   }
+  return result;
+}
 
-  return sum == original;
+/**
+ * @brief Counts the digits of a number in a base
+ * @param num Number to process
+ * @param base Base (2-36)
+ * @return Number of digits (1 for 0)
+ */
+int count_digits_in_base(unsigned long long num, int base)
+{
+  int digits = 1;
+  for (; num >= (unsigned long long)base; num /= (unsigned long long)base)
+    digits++;
+  return digits;
 }
 
 /**
- * @brief Fast integer power function
- * @param base Base number
- * @param exp Exponent
- * @return base raised to the power of exp
+ * @brief Builds the power, power-of-ten and block tables
  *
- * Uses exponentiation by squaring for efficiency.
+ * Must run before any search. Every entry is exact: 9^19 and 10^19 both
+ * fit in an unsigned long long.
  */
-long long ipow(long long base, int exp)
+void init_tables(void)
 {
-  long long result = 1;
-  while (exp > 0)
+  for (int length = 0; length <= MAX_DIGITS; length++)
   {
-    if (exp % 2 == 1)
+    for (int d = 0; d < 10; d++)
     {
-      result *= base;
+      unsigned long long p = 1;
+      for (int e = 0; e < length; e++)
+        p *= (unsigned long long)d;
+      digit_pow[length][d] = p;
     }
-    exp >>= 1;
-    base *= base;
+    pow10_table[length] = length == 0 ? 1 : pow10_table[length - 1] * 10;
   }
-  return result;
+
+  for (int length = BLOCK_DIGITS + 1; length <= MAX_DIGITS; length++)
+  {
+    const unsigned long long *row = digit_pow[length];
+    for (int lo = 0; lo < BLOCK_SIZE; lo++)
+    {
+      block_delta[length][lo] = row[lo % 10] + row[lo / 10 % 10] + row[lo / 100 % 10] + row[lo / 1000] -
+                                (unsigned long long)lo;
+    }
+  }
+}
+
+/**
+ * @brief Power-sum check for a fixed digit count
+ * @param num Number with exactly `length` digits
+ * @param length Digit count (a compile-time constant at every call site)
+ * @return true if num is an Armstrong number
+ *
+ * Inlined into one function per length below, so the digit loop is fully
+ * unrolled and has no data-dependent branches. Only 19-digit sums can
+ * exceed 2^64; that case carries an overflow flag instead of an early exit.
+ */
+static inline bool armstrong_check_length(unsigned long long num, const int length)
+{
+  const unsigned long long *row = digit_pow[length];
+  unsigned long long n = num;
+  unsigned long long sum = 0;
+  bool overflow = false;
+
+  for (int i = 0; i < length; i++)
+  {
+    if (length >= MAX_DIGITS)
+      overflow |= __builtin_add_overflow(sum, row[n % 10], &sum);
+    else
+      sum += row[n % 10];
+    n /= 10;
+  }
+  return sum == num && !overflow;
+}
+
+#define DEFINE_ARMSTRONG_CHECK(L)                           \
+  static bool is_armstrong_length_##L(unsigned long long num) \
+  {                                                         \
+    return armstrong_check_length(num, L);                  \
+  }
+
+DEFINE_ARMSTRONG_CHECK(1)
+DEFINE_ARMSTRONG_CHECK(2)
+DEFINE_ARMSTRONG_CHECK(3)
+DEFINE_ARMSTRONG_CHECK(4)
+DEFINE_ARMSTRONG_CHECK(5)
+DEFINE_ARMSTRONG_CHECK(6)
+DEFINE_ARMSTRONG_CHECK(7)
+DEFINE_ARMSTRONG_CHECK(8)
+DEFINE_ARMSTRONG_CHECK(9)
+DEFINE_ARMSTRONG_CHECK(10)
+DEFINE_ARMSTRONG_CHECK(11)
+DEFINE_ARMSTRONG_CHECK(12)
+DEFINE_ARMSTRONG_CHECK(13)
+DEFINE_ARMSTRONG_CHECK(14)
+DEFINE_ARMSTRONG_CHECK(15)
+DEFINE_ARMSTRONG_CHECK(16)
+DEFINE_ARMSTRONG_CHECK(17)
+DEFINE_ARMSTRONG_CHECK(18)
+DEFINE_ARMSTRONG_CHECK(19)
+
+/**
+ * @brief Length-specialised checks, indexed by digit count
+ */
+static bool (*const armstrong_checks[MAX_DIGITS + 1])(unsigned long long) = {
+    NULL, is_armstrong_length_1, is_armstrong_length_2, is_armstrong_length_3,
+    is_armstrong_length_4, is_armstrong_length_5, is_armstrong_length_6,
+    is_armstrong_length_7, is_armstrong_length_8, is_armstrong_length_9,
+    is_armstrong_length_10, is_armstrong_length_11, is_armstrong_length_12,
+    is_armstrong_length_13, is_armstrong_length_14, is_armstrong_length_15,
+    is_armstrong_length_16, is_armstrong_length_17, is_armstrong_length_18,
+    is_armstrong_length_19};
+
+/**
+ * @brief Checks if a number is an ArmstrongConfig number
+ * @param num Number to check
+ * @return true if ArmstrongConfig number, false otherwise
+ *
+ * Dispatches to the check specialised for the number's digit count.
+ */
+bool is_armstrong_number(long long num)
+{
+  if (num < 1)
+    return false;
+  return armstrong_checks[count_digits(num)]((unsigned long long)num);
 }
 
 /**
@@ -186,13 +2164,15 @@ long long ipow(long long base, int exp)
  * @param num Number to process
  * @return Number of digits
  *
- * Uses log10 for optimal performance with large numbers.
+ * Integer comparisons against the power-of-ten table (no floating point).
  */
 int count_digits(long long num)
 {
-  if (num == 0)
-    return 1;
-  return (int)floor(log10(llabs(num))) + 1;
+  unsigned long long n = num < 0 ? 0 - (unsigned long long)num : (unsigned long long)num;
+  int digits = 1;
+  while (digits <= MAX_DIGITS && n >= pow10_table[digits])
+    digits++;
+  return digits;
 }
 
 /**
@@ -229,7 +2209,7 @@ void process_input(ArmstrongConfig *config, const char *input)
       config->limit < 1 ||
       config->limit > MAX_RANGE)
   {
-    print_error("Invalid input. Please enter a number between 1 and 1000000000000000000");
+    print_error("Invalid input. Please enter a number between 1 and 9223372036854775807");
     exit(EXIT_FAILURE);
   }
 }
@@ -243,8 +2223,9 @@ void process_input(ArmstrongConfig *config, const char *input)
 bool parse_long_long(const char *str, long long *value)
 {
   char *endptr;
+  errno = 0;
   *value = strtoll(str, &endptr, 10);
-  return (endptr != str) && (*endptr == '\0' || *endptr == '\n');
+  return (endptr != str) && errno != ERANGE && (*endptr == '\0' || *endptr == '\n');
 }
 
 /**
@@ -257,20 +2238,48 @@ void print_error(const char *msg)
 }
 
 /**
- * @brief Single-threaded ArmstrongConfig number printer
+ * @brief Prints the search results
+ * @param results Numbers found, sorted
  * @param limit Upper search limit
- *
- * Used when thread_count = 1 for simpler execution
+ * @param count_only Print only how many numbers were found
+ * @param spec Base and exponent rule (numbers are printed in that base)
  */
-void print_armstrong_numbers(long long limit)
+void print_armstrong_numbers(const ResultVector *results, long long limit, bool count_only,
+                             const DigitPowerSpec *spec)
 {
-  printf("ArmstrongConfig numbers up to %lld:\n", limit);
-  for (long long i = 1; i <= limit; i++)
+  char name[64];
+  if (spec->rule == RULE_FIXED_POWER)
+    snprintf(name, sizeof(name), "Power-%d digit invariants", spec->power);
+  else
+    snprintf(name, sizeof(name), "%s numbers", spec->rule == RULE_MUNCHHAUSEN ? "Munchhausen" : "Armstrong");
+
+  char base_note[32] = "";
+  if (spec->base != 10)
+    snprintf(base_note, sizeof(base_note), " in base %d", spec->base);
+
+  if (count_only)
+  {
+    printf("Found %zu %s%s up to %lld\n", results->count, name, base_note, limit);
+    return;
+  }
+
+  printf("%s%s up to %lld:\n", name, base_note, limit);
+  for (size_t i = 0; i < results->count; i++)
   {
-    if (is_armstrong_number(i))
+    if (spec->base == 10)
+    {
+      printf("%llu ", results->items[i]);
+      continue;
+    }
+
+    char text[MAX_BASE_DIGITS + 1];
+    int pos = MAX_BASE_DIGITS;
+    text[pos] = '\0';
+    for (unsigned long long n = results->items[i]; n > 0; n /= (unsigned long long)spec->base)
     {
-      printf("%lld ", i);
+      text[--pos] = "0123456789abcdefghijklmnopqrstuvwxyz"[n % (unsigned long long)spec->base];
     }
+    printf("%s ", text + pos);
   }
   printf("\n");
 }
@@ -298,10 +2307,167 @@ void parse_args(int argc, char *argv[], ArmstrongConfig *config)
     }
     else if (strcmp(argv[i], "--threads") == 0 || strcmp(argv[i], "-t") == 0)
     {
-      if (++i < argc && parse_long_long(argv[i], (long long *)&config->threads) &&
-          config->threads >= 1 && config->threads <= MAX_THREADS)
+      long long threads;
+      if (++i < argc && parse_long_long(argv[i], &threads) && threads >= 1 && threads <= INT_MAX)
+      {
+        config->threads = (int)threads;
+        continue;
+      }
+      print_error("Thread count must be a positive integer");
+      exit(EXIT_FAILURE);
+    }
+    else if (strcmp(argv[i], "--method") == 0)
+    {
+      if (++i < argc && strcmp(argv[i], "multiset") == 0)
+      {
+        config->method = METHOD_MULTISET;
+        continue;
+      }
+      if (i < argc && strcmp(argv[i], "scan") == 0)
+      {
+        config->method = METHOD_SCAN;
+        continue;
+      }
+      print_error("Method must be multiset or scan");
+      exit(EXIT_FAILURE);
+    }
+    else if (strcmp(argv[i], "--base") == 0 || strcmp(argv[i], "-b") == 0)
+    {
+      long long base;
+      if (++i < argc && parse_long_long(argv[i], &base) && base >= MIN_BASE && base <= MAX_BASE)
+      {
+        config->spec.base = (int)base;
+        continue;
+      }
+      print_error("Base must be between 2 and 36");
+      exit(EXIT_FAILURE);
+    }
+    else if (strcmp(argv[i], "--power") == 0 || strcmp(argv[i], "-p") == 0)
+    {
+      long long power;
+      if (++i < argc && parse_long_long(argv[i], &power) && power >= 1 && power <= MAX_POWER &&
+          config->spec.rule != RULE_MUNCHHAUSEN)
+      {
+        config->spec.rule = RULE_FIXED_POWER;
+        config->spec.power = (int)power;
+        continue;
+      }
+      print_error("Power must be between 1 and 63 (and cannot be combined with --munchhausen)");
+      exit(EXIT_FAILURE);
+    }
+    else if (strcmp(argv[i], "--munchhausen") == 0)
+    {
+      if (config->spec.rule == RULE_FIXED_POWER)
+      {
+        print_error("--munchhausen cannot be combined with --power");
+        exit(EXIT_FAILURE);
+      }
+      config->spec.rule = RULE_MUNCHHAUSEN;
+    }
+    else if (strcmp(argv[i], "--digits") == 0 || strcmp(argv[i], "-d") == 0)
+    {
+      long long digits;
+      if (++i < argc && parse_long_long(argv[i], &digits) && digits >= 1 && digits <= MAX_WIDE_DIGITS)
+      {
+        config->wide_digits = (int)digits;
+        continue;
+      }
+      print_error("Digits must be between 1 and 39");
+      exit(EXIT_FAILURE);
+    }
+    else if (strcmp(argv[i], "--checkpoint") == 0)
+    {
+      if (++i < argc && strlen(argv[i]) < MAX_INPUT_LEN)
+      {
+        config->scan.checkpoint_path = argv[i];
+        continue;
+      }
+      print_error("Missing or too long file name after --checkpoint");
+      exit(EXIT_FAILURE);
+    }
+    else if (strcmp(argv[i], "--checkpoint-interval") == 0)
+    {
+      long long seconds;
+      if (++i < argc && parse_long_long(argv[i], &seconds) && seconds >= 1)
+      {
+        config->scan.checkpoint_interval = (double)seconds;
+        continue;
+      }
+      print_error("Checkpoint interval must be a positive number of seconds");
+      exit(EXIT_FAILURE);
+    }
+    else if (strcmp(argv[i], "--resume") == 0)
+    {
+      config->scan.resume = true;
+    }
+    else if (strcmp(argv[i], "--progress") == 0)
+    {
+      config->scan.progress = true;
+    }
+    else if (strcmp(argv[i], "--pin") == 0)
+    {
+      config->pin = true;
+    }
+    else if (strcmp(argv[i], "--scaling") == 0)
+    {
+      config->scaling = true;
+    }
+    else if (strcmp(argv[i], "--bench") == 0)
+    {
+      config->bench = true;
+    }
+    else if (strcmp(argv[i], "--bench-limits") == 0)
+    {
+      int low, high;
+      char tail;
+      if (++i < argc && sscanf(argv[i], "%d-%d%c", &low, &high, &tail) == 2 && low >= 0 && low <= high &&
+          high <= MAX_DIGITS - 1)
+      {
+        config->bench_min_exp = low;
+        config->bench_max_exp = high;
+        continue;
+      }
+      print_error("Benchmark limits must be exponents LOW-HIGH with 0 <= LOW <= HIGH <= 18");
+      exit(EXIT_FAILURE);
+    }
+    else if (strcmp(argv[i], "--format") == 0)
+    {
+      static const char *const format_names[] = {"text", "csv", "json"};
+      bool known = false;
+      if (++i < argc)
+      {
+        for (int k = 0; k < 3 && !known; k++)
+        {
+          known = strcmp(argv[i], format_names[k]) == 0;
+          if (known)
+            config->format = (ReportFormat)k;
+        }
+      }
+      if (known)
+        continue;
+      print_error("Format must be text, csv or json");
+      exit(EXIT_FAILURE);
+    }
+    else if (strcmp(argv[i], "--count") == 0 || strcmp(argv[i], "-c") == 0)
+    {
+      config->count_only = true;
+    }
+    else if (strcmp(argv[i], "--kernel") == 0)
+    {
+      static const char *const kernel_names[] = {"auto", "scalar", "avx2", "odometer"};
+      bool known = false;
+      if (++i < argc)
+      {
+        for (int k = 0; k < 4 && !known; k++)
+        {
+          known = strcmp(argv[i], kernel_names[k]) == 0;
+          if (known)
+            config->kernel = (ScanKernel)k;
+        }
+      }
+      if (known)
         continue;
-      print_error("Thread count must be between 1 and MAX_THREADS");
+      print_error("Kernel must be auto, scalar, avx2 or odometer");
       exit(EXIT_FAILURE);
     }
   }
@@ -317,5 +2483,21 @@ void print_help()
   printf("Options:\n");
   printf("  -h, --help        Show this help message\n");
   printf("  -n, --num LIMIT   Set upper search limit (1-%lld)\n", MAX_RANGE);
-  printf("  -t, --threads N   Set number of threads (1-%d)\n\n", MAX_THREADS);
+  printf("  -t, --threads N   Set number of threads (default: %d, the CPU count)\n", omp_get_num_procs());
+  printf("  --method NAME     multiset (default, fast) or scan (test every number)\n");
+  printf("  --kernel NAME     Scan kernel: auto (default), scalar, avx2 or odometer\n");
+  printf("  -c, --count       Print only how many numbers were found\n");
+  printf("  -d, --digits D    Find all Armstrong numbers with up to D digits (1-39, 128-bit)\n");
+  printf("  --checkpoint FILE Save scan progress to FILE (block scan only)\n");
+  printf("  --checkpoint-interval S  Seconds between checkpoints (default 60)\n");
+  printf("  --resume          Continue the scan saved in the --checkpoint file\n");
+  printf("  --progress        Show progress and ETA on stderr\n");
+  printf("  --pin             Pin each search thread to its own CPU\n");
+  printf("  --scaling         Also time 1, 2, 4, ... threads and print the speedup\n");
+  printf("  --bench           Benchmark limits 10^6..10^12 at 1, 2, 4, ... threads\n");
+  printf("  --bench-limits A-B  Benchmark limits 10^A..10^B instead\n");
+  printf("  --format NAME     Benchmark report: text (default), csv or json\n");
+  printf("  -b, --base B      Digits in base B (2-36, default 10)\n");
+  printf("  -p, --power P     Raise every digit to P instead of the digit count\n");
+  printf("  --munchhausen     Raise every digit to itself (0^0 = 0)\n\n");
 }
@@ -1,15 +1,55 @@
+#define _POSIX_C_SOURCE 200809L // mmap, open, fstat
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
 #include <string.h>
-#include <math.h>
+#include <stdint.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <omp.h>
 
 #define MAX_INPUT_LEN 256       // Maximum length for user input
 #define MAX_THREADS 16          // Maximum number of threads
-#define MAX_NUMBERS 1000        // Maximum numbers to process in batch mode
-#define MAX_BINARY_DIGITS 100   // Maximum binary digits to calculate
-#define RESIDUE_THRESHOLD 0.005 // Threshold for stopping the conversion
+#define CHUNK_NUMBERS 4096      // Numbers per pipeline chunk (file mode)
+#define PIPELINE_DEPTH 3        // Chunks in flight: read, convert, write
+#define PARTS_PER_THREAD 4      // Output buffers per thread and chunk (load balance)
+#define MAX_PARTS (MAX_THREADS * PARTS_PER_THREAD)
+#define MAX_FRACTION_BITS 1074 // Fraction bits of DBL_TRUE_MIN, the longest fraction
+#define MAX_BINARY_DIGITS (MAX_FRACTION_BITS + 1) // "0" plus the fraction bits; DBL_MAX needs 1024
+#define BINARY_BUFFER_SIZE (MAX_BINARY_DIGITS + 3) // Digits, sign, point and terminator
+#define EXACT_PRECISION -1     // No cutoff: print every fraction bit
+#define RECORD_BUFFER_SIZE (BINARY_BUFFER_SIZE + 160) // One formatted record, any format
+#define CSV_HEADER "decimal,binary,digits,truncated\n"
+#define SMALLEST_POWER_OF_TEN -342 // Below: every 19-digit significand rounds to 0
+#define LARGEST_POWER_OF_TEN 308   // Above: every nonzero significand overflows
+#define POW5_ENTRIES (LARGEST_POWER_OF_TEN - SMALLEST_POWER_OF_TEN + 1)
+#define MAX_FAST_DIGITS 19         // Significant digits that fit a uint64_t
+#define BIG_LIMBS 66               // 32-bit limbs of the table generator (2^2048 and up)
+#define POW5_DIVIDEND_BITS 2048    // Generator computes floor(2^2048 / 5^k)
+#define STREAM_READ_SIZE 65536     // Initial read buffer for pipes and other non-regular inputs
+
+/**
+ * @brief Layout of the conversion records
+ */
+typedef enum
+{
+  FORMAT_TEXT, ///< Decimal/Binary/Length block per number
+  FORMAT_CSV   ///< One CSV line per number
+} OutputFormat;
+
+/**
+ * @brief Growable byte buffer that formatted records are appended to
+ */
+typedef struct
+{
+  char *data;      ///< Formatted bytes
+  size_t length;   ///< Bytes used
+  size_t capacity; ///< Bytes allocated
+} OutputBuffer;
 
 /**
  * @brief Program configuration structure
@@ -21,19 +61,70 @@ typedef struct
   int threads;                  ///< Number of threads to use
   bool file_mode;               ///< Read numbers from file instead of stdin
   char filename[MAX_INPUT_LEN]; ///< Input file name
-  double numbers[MAX_NUMBERS];  ///< Array of numbers to process
+  int precision;                ///< Fraction bits to print (EXACT_PRECISION = all)
+  OutputFormat format;          ///< Record layout
+  bool speedup;                 ///< Time process_batch against the parallel path
+  bool parse_bench;             ///< Time the file readers in GB/s
+  double *numbers;              ///< Numbers given with -n or typed in (grows as needed)
+  int capacity;                 ///< Allocated size of numbers
 } ConverterConfig;
 
+/**
+ * @brief Input file read line by line: mapped if regular, else read in blocks
+ */
+typedef struct
+{
+  const char *name; ///< File name for error messages
+  const char *data; ///< Mapped bytes or the read buffer (NULL for an empty file)
+  size_t size;      ///< Bytes in the file (mapped) or in the buffer (streamed)
+  size_t offset;    ///< Start of the next unread line
+  int fd;           ///< Descriptor still being read (-1 if mapped or at end)
+  char *buffer;     ///< Read buffer of a non-regular input (NULL if mapped)
+  size_t capacity;  ///< Allocated size of buffer
+  long long line;   ///< Number of the last line read (1-based)
+  long long invalid; ///< Lines that were not a number
+  bool report;      ///< Print an error for each invalid line
+  bool fast;        ///< Use fast_parse_double (otherwise strtod only)
+} MappedInput;
+
+/**
+ * @brief One chunk of the file pipeline: inputs and their conversions
+ */
+typedef struct
+{
+  double *numbers;                ///< Parsed inputs
+  int count;                      ///< Numbers in the chunk (0 = input exhausted)
+  OutputBuffer parts[MAX_PARTS];  ///< Formatted records, one buffer per slice
+} ConversionChunk;
+
 /* Function prototypes */
 void parse_args(int argc, char *argv[], ConverterConfig *config);
 void print_help(void);
 bool parse_double(const char *str, double *value);
-void handle_input(ConverterConfig *config);
-void process_batch(ConverterConfig *config);
-void convert_decimal_to_binary(double number, char *binary, int *length);
+bool parse_number_text(const char *begin, const char *end, double *value, bool fast);
+bool fast_parse_double(const char *begin, const char *end, double *value);
+bool eisel_lemire(uint64_t w, int64_t q, bool negative, double *value);
+void init_pow5_table(void);
+void map_input(const char *filename, MappedInput *input);
+void unmap_input(MappedInput *input);
+bool next_number(MappedInput *input, double *value);
+bool refill_input(MappedInput *input);
+void run_parse_bench(ConverterConfig *config);
+void handle_input(ConverterConfig *config, FILE *status);
+void process_batch(ConverterConfig *config, FILE *out);
+int convert_decimal_to_binary(double number, int precision, char *binary, bool *truncated);
+size_t format_conversion(char *out, double number, int precision, OutputFormat format);
+void format_range(const double *numbers, int begin, int end, int precision, OutputFormat format,
+                  OutputBuffer *out);
+void output_reserve(OutputBuffer *buffer, size_t extra);
+void write_parts(OutputBuffer *parts, int count, OutputBuffer *stitched, FILE *out);
 void print_error(const char *msg);
-void read_numbers_from_file(ConverterConfig *config);
-void convert_decimal_to_binary_parallel(ConverterConfig *config);
+void add_number(ConverterConfig *config, double value);
+long long convert_file_streaming(ConverterConfig *config, long long *invalid);
+int read_chunk(MappedInput *input, ConversionChunk *chunk);
+void read_all_numbers(ConverterConfig *config);
+void report_speedup(ConverterConfig *config, FILE *status);
+void convert_decimal_to_binary_parallel(ConverterConfig *config, FILE *out);
 
 /**
  * @brief Main program entry point
@@ -48,9 +139,16 @@ int main(int argc, char *argv[])
       .help = false,
       .threads = 4,
       .file_mode = false,
-      .filename = {0}};
+      .filename = {0},
+      .precision = EXACT_PRECISION,
+      .format = FORMAT_TEXT,
+      .speedup = false,
+      .parse_bench = false,
+      .numbers = NULL,
+      .capacity = 0};
   double start_time, end_time;
 
+  init_pow5_table();
   parse_args(argc, argv, &config);
 
   if (config.help)
@@ -59,244 +157,1181 @@ int main(int argc, char *argv[])
     return 0;
   }
 
-  // If no numbers provided via command-line or file, get from stdin
-  if (config.count == 0 && !config.file_mode)
+  if (config.parse_bench)
+  {
+    if (!config.file_mode)
+    {
+      print_error("--parse-bench needs an input file (-f)");
+      exit(EXIT_FAILURE);
+    }
+    run_parse_bench(&config);
+    free(config.numbers);
+    return 0;
+  }
+
+  // Status lines go to stderr when stdout carries CSV
+  FILE *status = config.format == FORMAT_CSV ? stderr : stdout;
+
+  if (config.speedup)
   {
-    handle_input(&config);
+    if (config.file_mode)
+      read_all_numbers(&config);
+    else if (config.count == 0)
+      handle_input(&config, status);
+    report_speedup(&config, status);
+    free(config.numbers);
+    return 0;
   }
-  else if (config.file_mode)
+
+  // Files are streamed through the pipeline; read, conversion and output overlap
+  if (config.file_mode)
   {
-    read_numbers_from_file(&config);
+    fprintf(status, "Streaming %s using %d threads\n", config.filename, config.threads);
+    fflush(status);
+    if (config.format == FORMAT_CSV)
+      fputs(CSV_HEADER, stdout);
+    long long invalid = 0;
+    start_time = omp_get_wtime();
+    long long total = convert_file_streaming(&config, &invalid);
+    end_time = omp_get_wtime();
+    fflush(stdout);
+    fprintf(status, "Converted %lld numbers from %s\n", total, config.filename);
+    if (invalid > 0)
+      fprintf(status, "Skipped %lld invalid lines\n", invalid);
+    fprintf(status, "Time: %.4f seconds\n", end_time - start_time);
+    free(config.numbers);
+    return 0;
   }
 
+  // If no numbers provided via command-line, get from stdin
+  if (config.count == 0)
+  {
+    handle_input(&config, status);
+  }
+
+  if (config.format == FORMAT_CSV)
+    fputs(CSV_HEADER, stdout);
+
   start_time = omp_get_wtime();
 
   if (config.threads > 1 && config.count > 1)
   {
-    convert_decimal_to_binary_parallel(&config);
+    int num_threads = (config.count < config.threads) ? config.count : config.threads;
+    fprintf(status, "Processing %d numbers using %d threads\n", config.count, num_threads);
+    fflush(status);
+    convert_decimal_to_binary_parallel(&config, stdout);
   }
   else
   {
-    process_batch(&config);
+    process_batch(&config, stdout);
   }
 
   end_time = omp_get_wtime();
-  printf("Time: %.4f seconds\n", end_time - start_time);
+  fflush(stdout);
+  fprintf(status, "Time: %.4f seconds\n", end_time - start_time);
 
+  free(config.numbers);
   return 0;
 }
 
 /**
  * @brief Converts decimal floating point numbers to binary representation in parallel
- * @param conv Pointer to ConverterConfig configuration structure
+ * @param config Configuration (numbers, threads, precision, format)
+ * @param out Destination of the records
  *
- * Uses OpenMP to process multiple numbers concurrently for improved performance.
+ * The numbers are handled in chunks of CHUNK_NUMBERS. Each chunk is cut
+ * into PARTS_PER_THREAD slices per thread; a thread formats a slice into
+ * that slice's own buffer, so no lock is taken. Once the team is done the
+ * slices are stitched in input order and written with a single fwrite.
  */
-void convert_decimal_to_binary_parallel(ConverterConfig *config)
+void convert_decimal_to_binary_parallel(ConverterConfig *config, FILE *out)
 {
   int num_threads = (config->count < config->threads) ? config->count : config->threads;
-  printf("Processing %d numbers using %d threads\n", config->count, num_threads);
+  if (num_threads < 1)
+    num_threads = 1;
+  OutputBuffer parts[MAX_PARTS] = {0};
+  OutputBuffer stitched = {0};
 
 #pragma omp parallel num_threads(num_threads)
   {
-    char binary[MAX_BINARY_DIGITS + 1];
-    int length;
+    const int part_count = omp_get_num_threads() * PARTS_PER_THREAD;
 
-#pragma omp for schedule(dynamic, 1)
-    for (int i = 0; i < config->count; i++)
+    for (int begin = 0; begin < config->count; begin += CHUNK_NUMBERS)
     {
-      convert_decimal_to_binary(config->numbers[i], binary, &length);
+      const int size = (config->count - begin < CHUNK_NUMBERS) ? config->count - begin : CHUNK_NUMBERS;
 
-#pragma omp critical
+#pragma omp for schedule(dynamic, 1)
+      for (int p = 0; p < part_count; p++)
       {
-        printf("Decimal: %f\n", config->numbers[i]);
-        printf("Binary: %s\n", binary);
-        printf("Length: %d binary digits\n\n", length);
+        format_range(config->numbers, begin + size * p / part_count, begin + size * (p + 1) / part_count,
+                     config->precision, config->format, &parts[p]);
       }
+
+#pragma omp single
+      write_parts(parts, part_count, &stitched, out);
     }
   }
+
+  for (int p = 0; p < MAX_PARTS; p++)
+    free(parts[p].data);
+  free(stitched.data);
 }
 
 /**
  * @brief Processes a batch of numbers in single-threaded mode
- * @param conv Pointer to ConverterConfig configuration structure
+ * @param config Configuration (numbers, precision, format)
+ * @param out Destination of the records
+ *
+ * Same records as the parallel path, formatted by one thread and written
+ * with one fwrite per chunk.
  */
-void process_batch(ConverterConfig *config)
+void process_batch(ConverterConfig *config, FILE *out)
 {
-  char binary[MAX_BINARY_DIGITS + 1];
-  int length;
+  OutputBuffer buffer = {0};
 
-  for (int i = 0; i < config->count; i++)
+  for (int begin = 0; begin < config->count; begin += CHUNK_NUMBERS)
   {
-    convert_decimal_to_binary(config->numbers[i], binary, &length);
-    printf("Decimal: %f\n", config->numbers[i]);
-    printf("Binary: %s\n", binary);
-    printf("Length: %d binary digits\n\n", length);
+    const int end = (config->count - begin < CHUNK_NUMBERS) ? config->count : begin + CHUNK_NUMBERS;
+    buffer.length = 0;
+    format_range(config->numbers, begin, end, config->precision, config->format, &buffer);
+    fwrite(buffer.data, 1, buffer.length, out);
   }
+
+  free(buffer.data);
+}
+
+/**
+ * @brief Converts one number and formats its record
+ * @param out Destination of at least RECORD_BUFFER_SIZE chars
+ * @param number Number to convert
+ * @param precision Fraction bit cutoff
+ * @param format Record layout
+ * @return Bytes written (without terminator)
+ *
+ * The decimal is printed with 17 significant digits, enough to identify
+ * the double exactly. CSV records are "decimal,binary,digits,truncated"
+ * with truncated 0 or 1.
+ */
+size_t format_conversion(char *out, double number, int precision, OutputFormat format)
+{
+  char binary[BINARY_BUFFER_SIZE];
+  bool truncated;
+  const int length = convert_decimal_to_binary(number, precision, binary, &truncated);
+  int written;
+
+  if (format == FORMAT_CSV)
+    written = sprintf(out, "%.17g,%s,%d,%d\n", number, binary, length, truncated);
+  else if (truncated)
+    written = sprintf(out, "Decimal: %.17g\nBinary: %s (truncated to %d fraction bits)\nLength: %d binary digits\n\n",
+                      number, binary, precision, length);
+  else
+    written = sprintf(out, "Decimal: %.17g\nBinary: %s\nLength: %d binary digits\n\n", number, binary, length);
+
+  return (size_t)written;
+}
+
+/**
+ * @brief Appends the records of numbers[begin, end) to a buffer
+ * @param numbers Inputs
+ * @param begin First index
+ * @param end One past the last index
+ * @param precision Fraction bit cutoff
+ * @param format Record layout
+ * @param out Buffer to append to
+ */
+void format_range(const double *numbers, int begin, int end, int precision, OutputFormat format,
+                  OutputBuffer *out)
+{
+  for (int i = begin; i < end; i++)
+  {
+    output_reserve(out, RECORD_BUFFER_SIZE);
+    out->length += format_conversion(out->data + out->length, numbers[i], precision, format);
+  }
+}
+
+/**
+ * @brief Makes room for extra more bytes in a buffer
+ * @param buffer Buffer to grow
+ * @param extra Bytes that must fit after the current length
+ */
+void output_reserve(OutputBuffer *buffer, size_t extra)
+{
+  if (buffer->length + extra <= buffer->capacity)
+    return;
+
+  size_t capacity = buffer->capacity == 0 ? 65536 : buffer->capacity;
+  while (capacity < buffer->length + extra)
+    capacity *= 2;
+
+  char *data = realloc(buffer->data, capacity);
+  if (data == NULL)
+  {
+    print_error("Out of memory");
+    exit(EXIT_FAILURE);
+  }
+  buffer->data = data;
+  buffer->capacity = capacity;
+}
+
+/**
+ * @brief Stitches part buffers in order and writes them with one fwrite
+ * @param parts Part buffers in input order (emptied on return)
+ * @param count Number of parts
+ * @param stitched Scratch buffer receiving the concatenation
+ * @param out Destination stream
+ */
+void write_parts(OutputBuffer *parts, int count, OutputBuffer *stitched, FILE *out)
+{
+  size_t total = 0;
+  for (int p = 0; p < count; p++)
+    total += parts[p].length;
+
+  stitched->length = 0;
+  output_reserve(stitched, total);
+  for (int p = 0; p < count; p++)
+  {
+    if (parts[p].length > 0)
+      memcpy(stitched->data + stitched->length, parts[p].data, parts[p].length);
+    stitched->length += parts[p].length;
+    parts[p].length = 0;
+  }
+
+  fwrite(stitched->data, 1, stitched->length, out);
 }
 
 /**
  * @brief Converts a decimal floating point number to binary representation
  * @param number The decimal number to convert
- * @param binary Output parameter for binary string
- * @param length Output parameter for the length of binary representation
+ * @param precision Fraction bits to keep, or EXACT_PRECISION for all of them
+ * @param binary Output buffer of at least BINARY_BUFFER_SIZE chars
+ * @param truncated Output: set when fraction bits were cut off by precision
+ * @return Number of binary digits written (sign and point not counted)
  *
- * Uses the repeated multiplication method for the fractional part until
- * the residue is less than the threshold (0.005).
+ * Every finite double is m * 2^e with an integer m < 2^53, so its binary
+ * expansion is finite: the bits of m with the point placed e positions
+ * from the right. The sign, exponent and mantissa are taken from the
+ * IEEE-754 encoding and written left to right through a single cursor, so
+ * the cost is linear in the output. NaN and infinities are written as
+ * "nan", "inf" and "-inf" (0 digits).
  */
-void convert_decimal_to_binary(double number, char *binary, int *length)
+int convert_decimal_to_binary(double number, int precision, char *binary, bool *truncated)
 {
-  // Initialize binary string
-  binary[0] = '\0';
-  *length = 0;
+  uint64_t bits;
+  memcpy(&bits, &number, sizeof(bits));
+
+  const bool negative = bits >> 63;
+  const int exponent_field = (int)(bits >> 52 & 0x7ff);
+  uint64_t mantissa = bits & ((UINT64_C(1) << 52) - 1);
+  char *cursor = binary;
+  int digits = 0;
+  *truncated = false;
+
+  if (exponent_field == 0x7ff)
+  {
+    strcpy(binary, mantissa != 0 ? "nan" : negative ? "-inf" : "inf");
+    return 0;
+  }
+
+  if (negative)
+    *cursor++ = '-';
+
+  // number = mantissa * 2^shift
+  int shift = -1074;
+  if (exponent_field != 0)
+  {
+    mantissa |= UINT64_C(1) << 52;
+    shift = exponent_field - 1075;
+  }
 
-  // Handle negative numbers
-  if (number < 0)
+  if (mantissa == 0)
   {
-    number = -number;
-    strcat(binary, "-");
-    (*length)++;
+    *cursor++ = '0';
+    *cursor = '\0';
+    return 1;
   }
 
-  // Extract integer and fractional parts
-  long long int_part = (long long)number;
-  double frac_part = number - (double)int_part;
+  // Drop trailing zero bits so the expansion ends at its last 1
+  const int trailing = __builtin_ctzll(mantissa);
+  mantissa >>= trailing;
+  shift += trailing;
+  const int width = 64 - __builtin_clzll(mantissa); // Significant bits of mantissa
+
+  if (shift >= 0)
+  {
+    // Integer: the mantissa bits followed by shift zeros
+    for (int i = width - 1; i >= 0; i--)
+      *cursor++ = (char)('0' + (int)(mantissa >> i & 1));
+    memset(cursor, '0', (size_t)shift);
+    cursor += shift;
+    *cursor = '\0';
+    return width + shift;
+  }
 
-  // Handle integer part
-  if (int_part == 0)
+  // Fraction bits are bits fraction_bits-1 .. 0 of the mantissa
+  const int fraction_bits = -shift;
+  if (width > fraction_bits)
   {
-    strcat(binary, "0");
-    (*length)++;
+    for (int i = width - 1; i >= fraction_bits; i--)
+      *cursor++ = (char)('0' + (int)(mantissa >> i & 1));
+    digits = width - fraction_bits;
   }
   else
   {
-    // Convert integer part to binary
-    char int_binary[MAX_BINARY_DIGITS] = {0};
-    int int_pos = 0;
+    *cursor++ = '0';
+    digits = 1;
+  }
 
-    while (int_part > 0)
-    {
-      int_binary[int_pos++] = (int_part % 2) + '0';
-      int_part /= 2;
-    }
+  int kept = fraction_bits;
+  if (precision != EXACT_PRECISION && precision < fraction_bits)
+  {
+    kept = precision;
+    *truncated = true;
+  }
+  if (kept > 0)
+  {
+    *cursor++ = '.';
+    for (int i = fraction_bits - 1; i >= fraction_bits - kept; i--)
+      *cursor++ = i < width ? (char)('0' + (int)(mantissa >> i & 1)) : '0';
+  }
+  *cursor = '\0';
+  return digits + kept;
+}
 
-    // Reverse the integer binary
-    for (int i = int_pos - 1; i >= 0; i--)
+/**
+ * @brief Streams a file through a read -> convert -> write pipeline
+ * @param config Configuration (filename, threads, precision)
+ * @param invalid Output: lines that were not a number
+ * @return Number of values converted
+ *
+ * PIPELINE_DEPTH chunks of CHUNK_NUMBERS values rotate through the stages.
+ * While the team converts chunk k (a taskloop over its part buffers), one
+ * task reads chunk k+1 and another stitches and writes chunk k-1, so
+ * memory stays bounded whatever the file size and output keeps the input
+ * order. With one thread the stages run one after another.
+ */
+long long convert_file_streaming(ConverterConfig *config, long long *invalid)
+{
+  MappedInput input;
+  map_input(config->filename, &input);
+
+  ConversionChunk chunks[PIPELINE_DEPTH] = {0};
+  for (int c = 0; c < PIPELINE_DEPTH; c++)
+  {
+    chunks[c].numbers = malloc(CHUNK_NUMBERS * sizeof(*chunks[c].numbers));
+    if (chunks[c].numbers == NULL)
     {
-      char digit[2] = {int_binary[i], '\0'};
-      strcat(binary, digit);
-      (*length)++;
+      print_error("Out of memory");
+      exit(EXIT_FAILURE);
     }
   }
 
-  // Add decimal point if fractional part exists
-  if (frac_part > 0)
-  {
-    strcat(binary, ".");
-    (*length)++;
+  long long total = 0;
+  const int precision = config->precision;
+  const OutputFormat format = config->format;
+  const int part_count = config->threads * PARTS_PER_THREAD;
+  OutputBuffer stitched = {0};
+  read_chunk(&input, &chunks[0]);
 
-    // Process fractional part until residue < 0.005
-    int frac_digits = 0;
-    while (frac_part >= RESIDUE_THRESHOLD && frac_digits < MAX_BINARY_DIGITS - *length)
+#pragma omp parallel num_threads(config->threads)
+#pragma omp single
+  {
+    for (long long k = 0;; k++)
     {
-      frac_part *= 2;
-      int bit = (int)frac_part;
+      ConversionChunk *current = &chunks[k % PIPELINE_DEPTH];
+      ConversionChunk *next = &chunks[(k + 1) % PIPELINE_DEPTH];
+      ConversionChunk *previous = &chunks[(k + PIPELINE_DEPTH - 1) % PIPELINE_DEPTH];
+      const bool have_previous = k > 0 && previous->count > 0;
+      if (current->count == 0 && !have_previous)
+        break;
 
-      // Add the bit to binary string
-      char digit[2] = {bit + '0', '\0'};
-      strcat(binary, digit);
-      (*length)++;
-      frac_digits++;
+      if (current->count > 0)
+      {
+#pragma omp task firstprivate(next)
+        read_chunk(&input, next);
+      }
+      else
+      {
+        next->count = 0;
+      }
 
-      // Subtract the integer part
-      frac_part -= bit;
-    }
+      if (have_previous)
+      {
+#pragma omp task firstprivate(previous)
+        write_parts(previous->parts, part_count, &stitched, stdout);
+      }
 
-    // Add info about residue if we stopped due to threshold
-    if (frac_part >= RESIDUE_THRESHOLD)
-    {
-      char residue_info[50];
-      snprintf(residue_info, sizeof(residue_info), " (residue: %.6f)", frac_part);
-      strcat(binary, residue_info);
+      const int size = current->count;
+#pragma omp taskloop grainsize(1) firstprivate(current)
+      for (int p = 0; p < part_count; p++)
+      {
+        format_range(current->numbers, size * p / part_count, size * (p + 1) / part_count, precision, format,
+                     &current->parts[p]);
+      }
+
+#pragma omp taskwait
+      total += current->count;
     }
   }
+
+  *invalid = input.invalid;
+  unmap_input(&input);
+  for (int c = 0; c < PIPELINE_DEPTH; c++)
+  {
+    free(chunks[c].numbers);
+    for (int p = 0; p < MAX_PARTS; p++)
+      free(chunks[c].parts[p].data);
+  }
+  free(stitched.data);
+  return total;
 }
 
 /**
- * @brief Reads decimal numbers from an input file
- * @param conv Pointer to ConverterConfig configuration structure
+ * @brief Reads up to CHUNK_NUMBERS values from a mapped file
+ * @param input Mapped input
+ * @param chunk Chunk to fill
+ * @return Values read (0 at end of file)
  */
-void read_numbers_from_file(ConverterConfig *config)
+int read_chunk(MappedInput *input, ConversionChunk *chunk)
 {
-  FILE *file = fopen(config->filename, "r");
-  if (file == NULL)
+  chunk->count = 0;
+
+  double value;
+  while (chunk->count < CHUNK_NUMBERS && next_number(input, &value))
   {
-    print_error("Could not open input file");
+    chunk->numbers[chunk->count++] = value;
+  }
+  return chunk->count;
+}
+
+/**
+ * @brief Loads every number of the input file into config->numbers
+ * @param config Configuration (filename, numbers)
+ *
+ * Only used by --speedup, which needs the inputs in memory to time both
+ * paths on the same data.
+ */
+void read_all_numbers(ConverterConfig *config)
+{
+  MappedInput input;
+  map_input(config->filename, &input);
+
+  ConversionChunk chunk = {0};
+  chunk.numbers = malloc(CHUNK_NUMBERS * sizeof(*chunk.numbers));
+  if (chunk.numbers == NULL)
+  {
+    print_error("Out of memory");
     exit(EXIT_FAILURE);
   }
 
-  char line[MAX_INPUT_LEN];
-  config->count = 0;
+  while (read_chunk(&input, &chunk) > 0)
+  {
+    for (int i = 0; i < chunk.count; i++)
+      add_number(config, chunk.numbers[i]);
+  }
+
+  free(chunk.numbers);
+  unmap_input(&input);
+}
 
-  while (fgets(line, sizeof(line), file) && config->count < MAX_NUMBERS)
+/**
+ * @brief Times process_batch against the parallel path on the same numbers
+ * @param config Configuration (numbers, threads, precision, format)
+ * @param status Stream for the report
+ *
+ * Both paths format every record and write it to /dev/null, so the
+ * timings cover conversion, formatting and output but not the terminal.
+ * At least two numbers are needed for the parallel path to use a team.
+ */
+void report_speedup(ConverterConfig *config, FILE *status)
+{
+  if (config->count < 2)
   {
-    // Skip empty lines and comments
-    if (line[0] == '\n' || line[0] == '#')
-      continue;
+    print_error("--speedup needs at least two numbers to compare");
+    exit(EXIT_FAILURE);
+  }
+
+  FILE *sink = fopen("/dev/null", "w");
+  if (sink == NULL)
+  {
+    print_error("Could not open /dev/null");
+    exit(EXIT_FAILURE);
+  }
+
+  const int num_threads = (config->count < config->threads) ? config->count : config->threads;
 
-    // Remove newline character
-    line[strcspn(line, "\n")] = 0;
+  double start_time = omp_get_wtime();
+  process_batch(config, sink);
+  const double batch_time = omp_get_wtime() - start_time;
+
+  start_time = omp_get_wtime();
+  convert_decimal_to_binary_parallel(config, sink);
+  const double parallel_time = omp_get_wtime() - start_time;
+
+  fclose(sink);
+
+  fprintf(status, "Numbers: %d\n", config->count);
+  fprintf(status, "process_batch: %.4f seconds\n", batch_time);
+  fprintf(status, "parallel (%d threads): %.4f seconds\n", num_threads, parallel_time);
+  fprintf(status, "Speedup: %.2fx\n", parallel_time > 0 ? batch_time / parallel_time : 0.0);
+}
 
-    double value;
-    if (parse_double(line, &value))
+/**
+ * @brief Appends a number to the -n/interactive list, growing it as needed
+ * @param config Configuration holding the list
+ * @param value Number to append
+ */
+void add_number(ConverterConfig *config, double value)
+{
+  if (config->count == config->capacity)
+  {
+    int capacity = config->capacity == 0 ? 16 : config->capacity * 2;
+    double *numbers = realloc(config->numbers, (size_t)capacity * sizeof(*numbers));
+    if (numbers == NULL)
     {
-      config->numbers[config->count++] = value;
+      print_error("Out of memory");
+      exit(EXIT_FAILURE);
     }
+    config->numbers = numbers;
+    config->capacity = capacity;
   }
-
-  fclose(file);
-  printf("Read %d numbers from %s\n", config->count, config->filename);
+  config->numbers[config->count++] = value;
 }
 
 /**
  * @brief Handles user input for decimal numbers
  * @param conv Pointer to ConverterConfig configuration structure
+ * @param status Stream for prompts (stderr when stdout carries CSV)
  */
-void handle_input(ConverterConfig *config)
+void handle_input(ConverterConfig *config, FILE *status)
 {
   char input[MAX_INPUT_LEN];
   double value;
 
-  printf("Enter decimal numbers (one per line, empty line to finish):\n");
+  fprintf(status, "Enter decimal numbers (one per line, empty line to finish):\n");
 
-  while (config->count < MAX_NUMBERS)
+  while (true)
   {
-    printf("> ");
+    fprintf(status, "> ");
+    fflush(status);
     if (fgets(input, sizeof(input), stdin) == NULL || input[0] == '\n')
       break;
 
     if (parse_double(input, &value))
     {
-      config->numbers[config->count++] = value;
+      add_number(config, value);
     }
     else
     {
-      printf("Invalid input. Please enter a valid decimal number.\n");
+      fprintf(status, "Invalid input. Please enter a valid decimal number.\n");
     }
   }
 }
 
 /**
  * @brief Parses a string to double
- * @param str String to parse
+ * @param str String to parse (a trailing newline is allowed)
  * @param value Output parameter for parsed value
  * @return true if parsing succeeded, false otherwise
  */
 bool parse_double(const char *str, double *value)
 {
+  const char *end = str + strlen(str);
+  if (end > str && end[-1] == '\n')
+    end--;
+  return parse_number_text(str, end, value, true);
+}
+
+/**
+ * @brief Parses [begin, end) as one number
+ * @param begin First character
+ * @param end One past the last character (need not be a terminator)
+ * @param value Output parameter for parsed value
+ * @param fast Try fast_parse_double before strtod
+ * @return true if the whole text is a number strtod accepts
+ *
+ * Text the fast parser does not handle (hex floats, nan/inf, leading
+ * blanks, more than 19 significant digits) goes to strtod, so both paths
+ * accept exactly the same inputs and return the same doubles.
+ */
+bool parse_number_text(const char *begin, const char *end, double *value, bool fast)
+{
+  if (fast && fast_parse_double(begin, end, value))
+    return true;
+
+  const size_t length = (size_t)(end - begin);
+  char local[MAX_INPUT_LEN];
+  char *text = length < sizeof(local) ? local : malloc(length + 1);
+  if (text == NULL)
+  {
+    print_error("Out of memory");
+    exit(EXIT_FAILURE);
+  }
+  memcpy(text, begin, length);
+  text[length] = '\0';
+
   char *endptr;
-  *value = strtod(str, &endptr);
-  return (endptr != str) && (*endptr == '\0' || *endptr == '\n');
+  *value = strtod(text, &endptr);
+  const bool ok = endptr != text && *endptr == '\0';
+
+  if (text != local)
+    free(text);
+  return ok;
+}
+
+/* 128-bit truncated powers of five, 5^q for q in [SMALLEST, LARGEST]_POWER_OF_TEN,
+   normalised so bit 127 is set: high word at 2i, low word at 2i+1 */
+static uint64_t pow5_table[2 * POW5_ENTRIES];
+
+/* Exactly representable powers of ten for the Clinger fast path */
+static const double exact_pow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                     1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                     1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+/**
+ * @brief Parses a plain decimal or scientific number with correct rounding
+ * @param begin First character
+ * @param end One past the last character
+ * @param value Output parameter for parsed value
+ * @return true if [begin, end) was fully parsed, false to defer to strtod
+ *
+ * Accepts [+-]digits[.digits][(e|E)[+-]digits] with at most 19
+ * significant digits, read into w so the value is w * 10^q. Small cases
+ * are exact in double arithmetic (Clinger: w <= 2^53, |q| <= 22); the
+ * rest go through eisel_lemire.
+ */
+bool fast_parse_double(const char *begin, const char *end, double *value)
+{
+  const char *p = begin;
+  bool negative = false;
+  if (p < end && (*p == '-' || *p == '+'))
+  {
+    negative = *p == '-';
+    p++;
+  }
+
+  uint64_t w = 0;
+  int digits = 0;       // Significant digits in w
+  int64_t exponent = 0; // Decimal exponent of w's last digit
+  bool any_digit = false;
+
+  for (; p < end && (unsigned)(*p - '0') < 10; p++)
+  {
+    any_digit = true;
+    if (w == 0 && *p == '0')
+      continue; // Leading zero
+    if (digits == MAX_FAST_DIGITS)
+      return false;
+    w = w * 10 + (uint64_t)(*p - '0');
+    digits++;
+  }
+
+  if (p < end && *p == '.')
+  {
+    for (p++; p < end && (unsigned)(*p - '0') < 10; p++)
+    {
+      any_digit = true;
+      exponent--;
+      if (w == 0 && *p == '0')
+        continue;
+      if (digits == MAX_FAST_DIGITS)
+        return false;
+      w = w * 10 + (uint64_t)(*p - '0');
+      digits++;
+    }
+  }
+
+  if (!any_digit)
+    return false;
+
+  if (p < end && (*p == 'e' || *p == 'E'))
+  {
+    bool negative_exponent = false;
+    int64_t written = 0;
+    p++;
+    if (p < end && (*p == '-' || *p == '+'))
+    {
+      negative_exponent = *p == '-';
+      p++;
+    }
+    if (p == end || (unsigned)(*p - '0') >= 10)
+      return false;
+    for (; p < end && (unsigned)(*p - '0') < 10; p++)
+    {
+      if (written < 100000) // Far past the double range either way
+        written = written * 10 + (*p - '0');
+    }
+    exponent += negative_exponent ? -written : written;
+  }
+
+  if (p != end)
+    return false;
+
+  if (w == 0)
+  {
+    *value = negative ? -0.0 : 0.0;
+    return true;
+  }
+
+  // Clinger: w and 10^|q| are exact doubles, so one correctly rounded operation
+  if (w <= (UINT64_C(1) << 53) && exponent >= -22 && exponent <= 22)
+  {
+    double result = (double)w;
+    result = exponent < 0 ? result / exact_pow10[-exponent] : result * exact_pow10[exponent];
+    *value = negative ? -result : result;
+    return true;
+  }
+
+  return eisel_lemire(w, exponent, negative, value);
+}
+
+/**
+ * @brief Rounds w * 10^q to the nearest double (Eisel-Lemire)
+ * @param w Nonzero decimal significand
+ * @param q Decimal exponent
+ * @param negative Sign of the result
+ * @param value Output parameter for the double
+ * @return false in the rare case the 128-bit product cannot decide the rounding
+ *
+ * 10^q = 5^q * 2^q. w, shifted so its top bit is set, is multiplied by the
+ * truncated 128-bit 5^q from pow5_table; the top 55 bits of the product
+ * give the 53-bit mantissa plus a rounding bit, and the power of two comes
+ * from q * log2(10) (152170 + 65536) / 2^16 approximates it. Ties to even
+ * are only possible for q in [-4, 23] and are detected from the low word.
+ */
+bool eisel_lemire(uint64_t w, int64_t q, bool negative, double *value)
+{
+  uint64_t mantissa;
+  int64_t power2;
+
+  if (q < SMALLEST_POWER_OF_TEN)
+  {
+    mantissa = 0;
+    power2 = 0;
+  }
+  else if (q > LARGEST_POWER_OF_TEN)
+  {
+    mantissa = 0;
+    power2 = 0x7ff;
+  }
+  else
+  {
+    const int leading_zeros = __builtin_clzll(w);
+    w <<= leading_zeros;
+
+    const size_t index = 2 * (size_t)(q - SMALLEST_POWER_OF_TEN);
+    unsigned __int128 first = (unsigned __int128)w * pow5_table[index];
+    uint64_t high = (uint64_t)(first >> 64);
+    uint64_t low = (uint64_t)first;
+
+    // Only the top 55 bits matter; if the lower 9 are all ones a carry from the low word may reach them
+    const uint64_t precision_mask = UINT64_MAX >> 55;
+    if ((high & precision_mask) == precision_mask)
+    {
+      const unsigned __int128 second = (unsigned __int128)w * pow5_table[index + 1];
+      const uint64_t second_high = (uint64_t)(second >> 64);
+      low += second_high;
+      if (second_high > low)
+        high++;
+    }
+
+    // 5^q outside [5^-27, 5^55] is itself truncated: an all-ones low word is ambiguous
+    if (low == UINT64_MAX && (q < -27 || q > 55))
+      return false;
+
+    const int upper_bit = (int)(high >> 63);
+    const int shift = upper_bit + 64 - 52 - 3;
+    mantissa = high >> shift;
+    power2 = (((152170 + 65536) * q) >> 16) + 63 + upper_bit - leading_zeros + 1023;
+
+    if (power2 <= 0)
+    {
+      // Subnormal: shift into place, then round half up on the last bit
+      if (-power2 + 1 >= 64)
+      {
+        mantissa = 0;
+        power2 = 0;
+      }
+      else
+      {
+        mantissa >>= -power2 + 1;
+        mantissa += mantissa & 1;
+        mantissa >>= 1;
+        power2 = mantissa < (UINT64_C(1) << 52) ? 0 : 1;
+      }
+    }
+    else
+    {
+      // Exact halfway case: round to even instead of up
+      if (low <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1 && (mantissa << shift) == high)
+        mantissa &= ~UINT64_C(1);
+
+      mantissa += mantissa & 1;
+      mantissa >>= 1;
+      if (mantissa >= (UINT64_C(2) << 52))
+      {
+        mantissa = UINT64_C(1) << 52;
+        power2++;
+      }
+      mantissa &= ~(UINT64_C(1) << 52);
+      if (power2 >= 0x7ff)
+      {
+        power2 = 0x7ff;
+        mantissa = 0;
+      }
+    }
+  }
+
+  const uint64_t bits = mantissa | (uint64_t)power2 << 52 | (uint64_t)negative << 63;
+  memcpy(value, &bits, sizeof(*value));
+  return true;
+}
+
+/**
+ * @brief Returns the bit length of a little-endian 32-bit limb number
+ */
+static int big_bit_length(const uint32_t *limbs, int count)
+{
+  while (count > 0 && limbs[count - 1] == 0)
+    count--;
+  return count == 0 ? 0 : 32 * count - __builtin_clz(limbs[count - 1]);
+}
+
+/**
+ * @brief Returns bits [bit, bit + 64) of a limb number (bits below 0 read as 0)
+ */
+static uint64_t big_bits(const uint32_t *limbs, int count, int bit)
+{
+  uint64_t result = 0;
+  for (int i = 63; i >= 0; i--)
+  {
+    const int position = bit + i;
+    const uint64_t b = position >= 0 && position / 32 < count ? limbs[position / 32] >> (position % 32) & 1 : 0;
+    result = result << 1 | b;
+  }
+  return result;
+}
+
+/**
+ * @brief Fills pow5_table with 128-bit truncated powers of five
+ *
+ * Positive powers are the top 128 bits of 5^q. A negative power 5^-k is
+ * stored as the top 128 bits of floor(2^b / 5^k) + 1, with b chosen so the
+ * quotient keeps at least 128 significant bits; floor(2^b / 5^k) is read
+ * off floor(2^2048 / 5^k), which is built by k divisions by 5.
+ */
+void init_pow5_table(void)
+{
+  uint32_t power[BIG_LIMBS] = {1};            // 5^k
+  uint32_t quotient[BIG_LIMBS] = {0};         // floor(2^2048 / 5^k)
+  uint32_t shifted[BIG_LIMBS];
+  quotient[POW5_DIVIDEND_BITS / 32] = 1;
+
+  for (int k = 0; k <= -SMALLEST_POWER_OF_TEN; k++)
+  {
+    const int bits = big_bit_length(power, BIG_LIMBS);
+
+    if (k <= LARGEST_POWER_OF_TEN)
+    {
+      const size_t index = 2 * (size_t)(k - SMALLEST_POWER_OF_TEN);
+      pow5_table[index] = big_bits(power, BIG_LIMBS, bits - 64);
+      pow5_table[index + 1] = big_bits(power, BIG_LIMBS, bits - 128);
+    }
+
+    if (k > 0)
+    {
+      // floor(2^b / 5^k) + 1 = (quotient >> (2048 - b)) + 1
+      const int b = k <= 27 ? bits + 127 : 2 * bits + 128;
+      const int drop = POW5_DIVIDEND_BITS - b;
+      for (int i = 0; i < BIG_LIMBS; i++)
+      {
+        const int from = i + drop / 32;
+        uint64_t word = from < BIG_LIMBS ? quotient[from] : 0;
+        if (from + 1 < BIG_LIMBS)
+          word |= (uint64_t)quotient[from + 1] << 32;
+        shifted[i] = (uint32_t)(word >> (drop % 32));
+      }
+      for (int i = 0; i < BIG_LIMBS && ++shifted[i] == 0; i++)
+        ;
+
+      const int length = big_bit_length(shifted, BIG_LIMBS);
+      const size_t index = 2 * (size_t)(-k - SMALLEST_POWER_OF_TEN);
+      pow5_table[index] = big_bits(shifted, BIG_LIMBS, length - 64);
+      pow5_table[index + 1] = big_bits(shifted, BIG_LIMBS, length - 128);
+    }
+
+    // Next k: power *= 5, quotient /= 5
+    uint64_t carry = 0;
+    for (int i = 0; i < BIG_LIMBS; i++)
+    {
+      const uint64_t product = (uint64_t)power[i] * 5 + carry;
+      power[i] = (uint32_t)product;
+      carry = product >> 32;
+    }
+    uint64_t remainder = 0;
+    for (int i = BIG_LIMBS - 1; i >= 0; i--)
+    {
+      const uint64_t dividend = remainder << 32 | quotient[i];
+      quotient[i] = (uint32_t)(dividend / 5);
+      remainder = dividend % 5;
+    }
+  }
+}
+
+/**
+ * @brief Maps an input file into memory
+ * @param filename File to map
+ * @param input Mapped input to initialise (fast parser, errors reported)
+ *
+ * Pipes, FIFOs, terminals and /dev/stdin have no size to map; they are
+ * read in blocks by refill_input instead, with the same line handling.
+ */
+void map_input(const char *filename, MappedInput *input)
+{
+  *input = (MappedInput){.name = filename, .fd = -1, .report = true, .fast = true};
+
+  const int fd = open(filename, O_RDONLY);
+  struct stat info;
+  if (fd < 0 || fstat(fd, &info) != 0)
+  {
+    print_error("Could not open input file");
+    exit(EXIT_FAILURE);
+  }
+
+  if (!S_ISREG(info.st_mode))
+  {
+    input->fd = fd;
+    return;
+  }
+
+  input->size = (size_t)info.st_size;
+  if (input->size > 0)
+  {
+    void *data = mmap(NULL, input->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED)
+    {
+      print_error("Could not map input file");
+      exit(EXIT_FAILURE);
+    }
+    posix_madvise(data, input->size, POSIX_MADV_SEQUENTIAL);
+    input->data = data;
+  }
+  close(fd);
+}
+
+/**
+ * @brief Unmaps an input file
+ * @param input Mapped input
+ */
+void unmap_input(MappedInput *input)
+{
+  if (input->fd >= 0)
+    close(input->fd);
+  if (input->buffer != NULL)
+    free(input->buffer);
+  else if (input->data != NULL)
+    munmap((void *)input->data, input->size);
+  input->fd = -1;
+  input->buffer = NULL;
+  input->data = NULL;
+}
+
+/**
+ * @brief Reads more of a non-regular input into its buffer
+ * @param input Input being streamed
+ * @return true if bytes were added, false at end of input (or if mapped)
+ *
+ * The unread tail is moved to the front first; the buffer only grows when
+ * a single line does not fit, so memory stays bounded by the longest line.
+ */
+bool refill_input(MappedInput *input)
+{
+  if (input->fd < 0)
+    return false;
+
+  const size_t unread = input->size - input->offset;
+  if (unread > 0)
+    memmove(input->buffer, input->buffer + input->offset, unread);
+  input->size = unread;
+  input->offset = 0;
+
+  if (input->size == input->capacity)
+  {
+    const size_t capacity = input->capacity == 0 ? STREAM_READ_SIZE : input->capacity * 2;
+    char *buffer = realloc(input->buffer, capacity);
+    if (buffer == NULL)
+    {
+      print_error("Out of memory");
+      exit(EXIT_FAILURE);
+    }
+    input->buffer = buffer;
+    input->capacity = capacity;
+  }
+  input->data = input->buffer;
+
+  ssize_t bytes;
+  do
+  {
+    bytes = read(input->fd, input->buffer + input->size, input->capacity - input->size);
+  } while (bytes < 0 && errno == EINTR);
+
+  if (bytes < 0)
+  {
+    print_error("Could not read input file");
+    exit(EXIT_FAILURE);
+  }
+  if (bytes == 0)
+  {
+    close(input->fd);
+    input->fd = -1;
+    return false;
+  }
+  input->size += (size_t)bytes;
+  return true;
+}
+
+/**
+ * @brief Parses the next number of a mapped file
+ * @param input Mapped input
+ * @param value Output parameter for the number
+ * @return false at end of file
+ *
+ * Empty lines and lines starting with '#' are skipped. Other lines that
+ * are not a number are counted and, if input->report is set, reported
+ * with their line number on stderr.
+ */
+bool next_number(MappedInput *input, double *value)
+{
+  while (true)
+  {
+    const char *newline =
+        input->offset < input->size ? memchr(input->data + input->offset, '\n', input->size - input->offset) : NULL;
+    // A streamed input may hold only part of the line so far
+    if (newline == NULL && refill_input(input))
+      continue;
+    if (input->offset >= input->size)
+      return false;
+
+    const char *begin = input->data + input->offset;
+    const char *end = newline != NULL ? newline : input->data + input->size;
+    input->offset = (size_t)(end - input->data) + (newline != NULL);
+    input->line++;
+
+    // Skip empty lines and comments
+    if (begin == end || *begin == '#')
+      continue;
+
+    if (parse_number_text(begin, end, value, input->fast))
+      return true;
+
+    input->invalid++;
+    if (input->report)
+    {
+      char message[MAX_INPUT_LEN + 64];
+      const int length = end - begin > 40 ? 40 : (int)(end - begin);
+      snprintf(message, sizeof(message), "%s:%lld: invalid number \"%.*s\"", input->name, input->line, length,
+               begin);
+      print_error(message);
+    }
+  }
+}
+
+/**
+ * @brief Times the file readers and reports their throughput in GB/s
+ * @param config Configuration (filename)
+ *
+ * Compares the previous reader (fgets + strtod), strtod on the mapped
+ * file and the fast parser on the mapped file. Each reader runs three
+ * times and the best time is kept; a hash of the parsed bits checks that
+ * all of them return the same doubles.
+ */
+void run_parse_bench(ConverterConfig *config)
+{
+  static const char *const names[] = {"fgets + strtod", "mmap + strtod", "mmap + fast parser"};
+  uint64_t hashes[3] = {0};
+  long long counts[3] = {0};
+
+  struct stat info;
+  if (stat(config->filename, &info) != 0)
+  {
+    print_error("Could not open input file");
+    exit(EXIT_FAILURE);
+  }
+  if (!S_ISREG(info.st_mode))
+  {
+    print_error("--parse-bench reads the file several times and needs a regular file");
+    exit(EXIT_FAILURE);
+  }
+  const size_t bytes = (size_t)info.st_size;
+
+  printf("%-20s %10s %10s %8s\n", "reader", "numbers", "seconds", "GB/s");
+
+  for (int reader = 0; reader < 3; reader++)
+  {
+    double best = 0;
+    for (int run = 0; run < 3; run++)
+    {
+      uint64_t hash = 0;
+      long long count = 0;
+      double value;
+      const double start_time = omp_get_wtime();
+
+      if (reader == 0)
+      {
+        FILE *file = fopen(config->filename, "r");
+        if (file == NULL)
+        {
+          print_error("Could not open input file");
+          exit(EXIT_FAILURE);
+        }
+        char line[MAX_INPUT_LEN];
+        while (fgets(line, sizeof(line), file))
+        {
+          if (line[0] == '\n' || line[0] == '#')
+            continue;
+          line[strcspn(line, "\n")] = 0;
+          char *endptr;
+          value = strtod(line, &endptr);
+          if (endptr != line && *endptr == '\0')
+          {
+            uint64_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            hash = hash * 31 + bits;
+            count++;
+          }
+        }
+        fclose(file);
+      }
+      else
+      {
+        MappedInput input;
+        map_input(config->filename, &input);
+        input.report = false;
+        input.fast = reader == 2;
+        while (next_number(&input, &value))
+        {
+          uint64_t bits;
+          memcpy(&bits, &value, sizeof(bits));
+          hash = hash * 31 + bits;
+          count++;
+        }
+        unmap_input(&input);
+      }
+
+      const double elapsed = omp_get_wtime() - start_time;
+      if (run == 0 || elapsed < best)
+        best = elapsed;
+      hashes[reader] = hash;
+      counts[reader] = count;
+    }
+
+    printf("%-20s %10lld %10.4f %8.3f\n", names[reader], counts[reader], best, best > 0 ? bytes / best / 1e9 : 0.0);
+  }
+
+  const bool same = hashes[0] == hashes[2] && hashes[1] == hashes[2] && counts[0] == counts[2] && counts[1] == counts[2];
+  printf("Input: %s (%zu bytes)\n", config->filename, bytes);
+  printf("Results identical: %s\n", same ? "yes" : "NO");
+  if (!same)
+    exit(EXIT_FAILURE);
 }
 
 /**
@@ -346,15 +1381,58 @@ void parse_args(int argc, char *argv[], ConverterConfig *config)
       }
       else
       {
-        print_error("Thread count must be between 1 and MAX_THREADS");
+        char message[64];
+        snprintf(message, sizeof(message), "Thread count must be between 1 and %d", MAX_THREADS);
+        print_error(message);
+        exit(EXIT_FAILURE);
+      }
+    }
+    else if (strcmp(argv[i], "--precision") == 0 || strcmp(argv[i], "-p") == 0)
+    {
+      long long precision;
+      if (++i < argc && sscanf(argv[i], "%lld", &precision) == 1 &&
+          precision >= 0 && precision <= MAX_FRACTION_BITS)
+      {
+        config->precision = (int)precision;
+      }
+      else
+      {
+        char message[64];
+        snprintf(message, sizeof(message), "Precision must be between 0 and %d fraction bits", MAX_FRACTION_BITS);
+        print_error(message);
+        exit(EXIT_FAILURE);
+      }
+    }
+    else if (strcmp(argv[i], "--format") == 0)
+    {
+      if (++i < argc && strcmp(argv[i], "text") == 0)
+      {
+        config->format = FORMAT_TEXT;
+      }
+      else if (i < argc && strcmp(argv[i], "csv") == 0)
+      {
+        config->format = FORMAT_CSV;
+      }
+      else
+      {
+        print_error("Format must be text or csv");
         exit(EXIT_FAILURE);
       }
     }
+    else if (strcmp(argv[i], "--speedup") == 0)
+    {
+      config->speedup = true;
+    }
+    else if (strcmp(argv[i], "--parse-bench") == 0)
+    {
+      config->parse_bench = true;
+    }
     else if (strcmp(argv[i], "--number") == 0 || strcmp(argv[i], "-n") == 0)
     {
-      if (++i < argc && parse_double(argv[i], &config->numbers[config->count]))
+      double value;
+      if (++i < argc && parse_double(argv[i], &value))
       {
-        config->count++;
+        add_number(config, value);
       }
       else
       {
@@ -371,15 +1449,20 @@ void parse_args(int argc, char *argv[], ConverterConfig *config)
 void print_help()
 {
   printf("\nDecimal to Binary ConverterConfig\n\n");
-  printf("This program converts decimal floating point numbers to their binary representation\n");
-  printf("until the residue (remaining fractional part) is less than 0.005.\n\n");
+  printf("This program converts decimal floating point numbers to their exact binary representation\n");
+  printf("(every double has a finite binary expansion).\n\n");
   printf("Usage: decimal_to_binary [options]\n\n");
   printf("Options:\n");
   printf("  -h, --help         Show this help message\n");
   printf("  -n, --number NUM   Add a number to process\n");
   printf("  -f, --file FILE    Read numbers from file (one per line)\n");
-  printf("  -t, --threads N    Set number of threads (1-%d)\n\n", MAX_THREADS);
+  printf("  -p, --precision N  Stop the fraction after N bits (default: exact)\n");
+  printf("  -t, --threads N    Set number of threads (1-%d)\n", MAX_THREADS);
+  printf("      --format F     Record layout: text (default) or csv\n");
+  printf("      --speedup      Time process_batch against the parallel path\n");
+  printf("      --parse-bench  Time the file readers (GB/s) on the -f file\n\n");
   printf("Examples:\n");
   printf("  ./decimal_to_binary -n 123.456 -n 0.1 -t 2\n");
-  printf("  ./decimal_to_binary -f numbers.txt -t 4\n\n");
+  printf("  ./decimal_to_binary -f numbers.txt -t 4\n");
+  printf("  ./decimal_to_binary -f numbers.txt --format csv > out.csv\n\n");
 }
\ No newline at end of file